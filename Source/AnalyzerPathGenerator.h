@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "Fifo.h"
 template<typename PathType>
 struct AnalyzerPathGenerator
 {
@@ -25,7 +26,13 @@ struct AnalyzerPathGenerator
 
 		int numBins = (int)fftSize / 2;
 
-		PathType p;
+		//built in its fifo slot, which keeps the storage of whatever path it held before
+		auto* slot = pathFifo.acquireWriteSlot();
+		if (slot == nullptr)
+			return;
+
+		auto& p = *slot;
+		p.clear();
 		p.preallocateSpace(3 * (int)fftBounds.getWidth());
 
 		auto map = [bottom, top, negativeInfinity](float v)
@@ -33,11 +40,14 @@ struct AnalyzerPathGenerator
 			return juce::jmap(v, negativeInfinity, MAX_DECIBELS, bottom, top);
 		};
 
+		//the path is built where it will be drawn, so painting it needs no transform or copy
+		auto left = fftBounds.getX();
+
 		auto y = map(renderData[0]);
 		if (std::isnan(y) || std::isinf(y))
 			y = bottom;
 
-		p.startNewSubPath(0, y);
+		p.startNewSubPath(left, y);
 
 		const int pathResolution = 2;
 
@@ -50,11 +60,11 @@ struct AnalyzerPathGenerator
 				auto binFreq = binNum * binWidth;
 				auto normalizedBinX = juce::mapFromLog10(binFreq, 20.f, 20000.f);
 				int binX = std::floor(normalizedBinX * width);
-				p.lineTo(binX, y);
+				p.lineTo(left + binX, y);
 			}
 		}
 
-		pathFifo.push(p);
+		pathFifo.commitWriteSlot();
 	}
 
 	int getNumPathsAvailable() const
@@ -66,6 +76,19 @@ struct AnalyzerPathGenerator
 	{
 		return pathFifo.pull(path);
 	}
+
+	//swaps the oldest path into path rather than copying it, the slot gets path's old storage to reuse
+	bool swapPath(PathType& path)
+	{
+		if (auto* slot = pathFifo.acquireReadSlot())
+		{
+			std::swap(path, *slot);
+			pathFifo.releaseReadSlot();
+			return true;
+		}
+
+		return false;
+	}
 private:
 	Fifo<PathType> pathFifo;
 };
\ No newline at end of file
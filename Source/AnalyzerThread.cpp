@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    AnalyzerThread.cpp
+    Created: 17 Oct 2026 8:14:06pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include "AnalyzerThread.h"
+
+AnalyzerThread::AnalyzerThread(MBDistortionAudioProcessor& processor) :
+	juce::Thread("Spectrum Analyzer"),
+	audioProcessor(processor),
+	leftPathProducer(processor.leftChannelFifo),
+	rightPathProducer(processor.rightChannelFifo)
+{
+	startThread(juce::Thread::Priority::low);
+}
+
+AnalyzerThread::~AnalyzerThread()
+{
+	stopThread(1000);
+}
+
+void AnalyzerThread::setBounds(juce::Rectangle<float> newFFTBounds, float newNegativeInfinity)
+{
+	const juce::SpinLock::ScopedLockType lock(boundsLock);
+	fftBounds = newFFTBounds;
+	negativeInfinity = newNegativeInfinity;
+}
+
+bool AnalyzerThread::pullPaths()
+{
+	auto leftPulled = leftPathProducer.pullPath();
+	auto rightPulled = rightPathProducer.pullPath();
+	return leftPulled || rightPulled;
+}
+
+void AnalyzerThread::run()
+{
+	while (!threadShouldExit())
+	{
+		if (enabled.load(std::memory_order_relaxed))
+		{
+			juce::Rectangle<float> bounds;
+			auto negInf = 0.f;
+			{
+				const juce::SpinLock::ScopedLockType lock(boundsLock);
+				bounds = fftBounds;
+				negInf = negativeInfinity;
+			}
+
+			if (!bounds.isEmpty())
+			{
+				auto sampleRate = audioProcessor.getSampleRate();
+
+				leftPathProducer.updateNegativeInfinity(negInf);
+				rightPathProducer.updateNegativeInfinity(negInf);
+				leftPathProducer.process(bounds, sampleRate);
+				rightPathProducer.process(bounds, sampleRate);
+			}
+		}
+
+		wait(analysisIntervalMs);
+	}
+}
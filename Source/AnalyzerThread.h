@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    AnalyzerThread.h
+    Created: 17 Oct 2026 8:14:06pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PathProducer.h"
+
+/*
+	Runs the spectrum pipeline for both channels off the message thread: draining the sample rings, the FFTs,
+	the dB conversion and building the paths. Finished paths go out through each PathProducer's path fifo, so
+	the message thread only swaps the newest ones in and strokes them. The analyzer's bounds are the one thing
+	that flows the other way, under a spin lock neither side holds for more than a copy.
+*/
+struct AnalyzerThread : private juce::Thread
+{
+	AnalyzerThread(MBDistortionAudioProcessor& processor);
+	~AnalyzerThread() override;
+
+	//message thread: where the paths are drawn, and the level at the bottom edge of that area
+	void setBounds(juce::Rectangle<float> fftBounds, float negativeInfinity);
+
+	//message thread: a disabled analyzer leaves the rings alone, they're caught up when it's enabled again
+	void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+
+	//message thread: true if either channel has a new path since the last call
+	bool pullPaths();
+
+	const juce::Path& getLeftPath() const { return leftPathProducer.getPath(); }
+	const juce::Path& getRightPath() const { return rightPathProducer.getPath(); }
+private:
+	//the editor repaints at 60Hz, paths made any faster would never be seen
+	static constexpr int analysisIntervalMs = 1000 / 60;
+
+	MBDistortionAudioProcessor& audioProcessor;
+	PathProducer leftPathProducer, rightPathProducer;
+
+	std::atomic<bool> enabled{ true };
+
+	juce::SpinLock boundsLock;
+	juce::Rectangle<float> fftBounds;
+	float negativeInfinity{ -48.f };
+
+	void run() override;
+};
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    BandBufferArena.h
+    Created: 17 Oct 2026 2:41:09pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+	Scratch channels for every band in one allocation. Each channel starts on a cache line,
+	so the SIMD kernels get aligned loads and neighbouring bands never share a line.
+	All the allocation happens in prepare(), getBlock() only hands out views.
+*/
+template<typename SampleType>
+struct BandBufferArena
+{
+	void prepare(int numBands, int numChannels, int maxSamples)
+	{
+		bands = numBands;
+		channels = numChannels;
+		capacity = maxSamples;
+
+		channelStride = static_cast<size_t>(maxSamples + samplesPerLine - 1) / samplesPerLine * samplesPerLine;
+		auto totalSamples = channelStride * static_cast<size_t>(numBands * numChannels);
+
+		storage.allocate(totalSamples + samplesPerLine, true);
+		auto* base = juce::snapPointerToAlignment(storage.get(), alignmentBytes);
+
+		channelPointers.resize(static_cast<size_t>(numBands * numChannels));
+		for (size_t i = 0; i < channelPointers.size(); ++i)
+		{
+			channelPointers[i] = base + i * channelStride;
+		}
+	}
+
+	int getMaxSamples() const noexcept { return capacity; }
+	int getNumChannels() const noexcept { return channels; }
+
+	juce::dsp::AudioBlock<SampleType> getBlock(int band, size_t numSamples) const noexcept
+	{
+		jassert(band < bands);
+		jassert(numSamples <= static_cast<size_t>(capacity));
+
+		return juce::dsp::AudioBlock<SampleType>(channelPointers.data() + band * channels,
+			static_cast<size_t>(channels),
+			numSamples);
+	}
+private:
+	static constexpr size_t alignmentBytes = 64;
+	static constexpr size_t samplesPerLine = alignmentBytes / sizeof(SampleType);
+
+	juce::HeapBlock<SampleType> storage;
+	std::vector<SampleType*> channelPointers;
+	size_t channelStride{ 0 };
+
+	int bands{ 0 }, channels{ 0 }, capacity{ 0 };
+};
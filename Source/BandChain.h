@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    BandChain.h
+    Created: 17 Oct 2026 5:04:13pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+#include "Crossover.h"
+#include "DistortionBand.h"
+#include "BandBufferArena.h"
+#include "QuantumFifo.h"
+
+//everything that runs at the host's sample type, so the processor can hold one for float and one for double
+template<typename SampleType>
+struct BandChain
+{
+	MultiBandCrossover<SampleType, Params::MaxBands> crossover;
+	std::array<DistortionBand<SampleType>, Params::MaxBands> bands;
+
+	//the top band is written straight into the host buffer, only the ones below it need scratch space
+	BandBufferArena<SampleType> arena;
+
+	//only used in amortized block mode, not part of reset() since it holds audio rather than filter state
+	QuantumFifo<SampleType> quantumFifo;
+
+	void prepare(const juce::dsp::ProcessSpec& spec, int quantumSize)
+	{
+		crossover.prepare(spec);
+
+		//every band is prepared up front so changing the band count never allocates
+		for (auto& band : bands)
+		{
+			band.prepare(spec);
+		}
+
+		arena.prepare(Params::MaxBands - 1, static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+		quantumFifo.prepare(static_cast<int>(spec.numChannels), quantumSize);
+	}
+
+	void reset()
+	{
+		crossover.reset();
+		for (auto& band : bands)
+		{
+			band.reset();
+		}
+	}
+};
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    BandWorkers.cpp
+    Created: 17 Oct 2026 6:20:47pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include "BandWorkers.h"
+
+BandWorkers::BandWorkers()
+{
+}
+
+BandWorkers::~BandWorkers()
+{
+	release();
+}
+
+void BandWorkers::prepare(int numWorkers)
+{
+	if (numWorkers == static_cast<int>(workers.size()))
+	{
+		return;
+	}
+
+	release();
+
+	for (int i = 0; i < numWorkers; ++i)
+	{
+		workers.push_back(std::make_unique<Worker>(*this, i));
+		workers.back()->startRealtimeThread(juce::Thread::RealtimeOptions{});
+	}
+
+	active.store(numWorkers > 0);
+}
+
+void BandWorkers::release()
+{
+	//once active is clear and no call is busy, no tryRun() can be touching the workers until the next prepare()
+	active.store(false);
+	while (busy.load())
+	{
+		std::this_thread::yield();
+	}
+
+	for (auto& worker : workers)
+	{
+		worker->signalThreadShouldExit();
+		worker->notify();
+	}
+
+	for (auto& worker : workers)
+	{
+		worker->stopThread(1000);
+	}
+
+	workers.clear();
+}
+
+void BandWorkers::claimAndRun(uint32_t generation) noexcept
+{
+	//the tasks are band chains, so they get the same denormal protection and checks as the audio thread
+	juce::ScopedNoDenormals noDenormals;
+	RealtimeChecks::ScopedRealtimeCheck realtimeCheck;
+
+	auto word = work.load(std::memory_order_acquire);
+	for (;;)
+	{
+		const auto numTasks = static_cast<int>((word >> 16) & 0xffff);
+		const auto next = static_cast<int>(word & 0xffff);
+
+		if (getGeneration(word) != generation || next >= numTasks)
+		{
+			return;
+		}
+
+		if (work.compare_exchange_weak(word, pack(generation, numTasks, next + 1), std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			job(jobContext, next);
+			remaining.fetch_sub(1, std::memory_order_acq_rel);
+			word = work.load(std::memory_order_acquire);
+		}
+	}
+}
+
+BandWorkers::Worker::Worker(BandWorkers& ownerToUse, int index) :
+	juce::Thread("Band Worker " + juce::String(index + 1)),
+	owner(ownerToUse)
+{
+}
+
+void BandWorkers::Worker::run()
+{
+	auto lastGeneration = getGeneration(owner.work.load(std::memory_order_acquire));
+	auto spins = 0;
+
+	while (!threadShouldExit())
+	{
+		auto generation = getGeneration(owner.work.load(std::memory_order_acquire));
+		if (generation != lastGeneration)
+		{
+			lastGeneration = generation;
+			owner.claimAndRun(generation);
+			spins = 0;
+			continue;
+		}
+
+		//nothing ever notifies a worker but release(), so the wait is only a timed poll
+		if (++spins <= maxIdleSpins)
+		{
+			pause();
+		}
+		else if (spins <= maxIdleSpins + maxIdleYields)
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			wait(idlePollMs);
+		}
+	}
+}
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    BandWorkers.h
+    Created: 17 Oct 2026 6:20:47pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "RealtimeChecks.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+/*
+	A few real-time worker threads that the audio thread can hand independent tasks to, one per band.
+
+	run() publishes the job by bumping one atomic word that packs a generation, the task count and the next
+	unclaimed task. Workers and the calling thread then claim tasks from it with compare-and-swap until none
+	are left, and the caller spins (then yields) until every claimed task has finished. Claiming and joining
+	never allocate or lock, and the audio thread never wakes anyone: idle workers spin, then yield, then poll
+	every millisecond, so back-to-back blocks find them awake and a worker that is late finds its share already
+	taken by the caller. Polling costs a little CPU, but the pool only exists while parallel bands are on.
+
+	The threads only exist while the pool is prepared with some workers. tryRun() marks itself busy before checking
+	that the pool is active and prepare() clears active before waiting out any busy call, so the audio thread
+	never sees the threads being started or stopped, it just runs the tasks itself while there are none.
+*/
+struct BandWorkers
+{
+	BandWorkers();
+	~BandWorkers();
+
+	//starts or stops threads to match numWorkers, so call it off the audio thread, and from one thread at a time
+	void prepare(int numWorkers);
+	void release();
+
+	//runs task(0) ... task(numTasks - 1) across the workers and the calling thread and returns true once all are done,
+	//or returns false straight away without running any when there are no workers
+	template<typename Task>
+	bool tryRun(int numTasks, Task& task) noexcept
+	{
+		jassert(numTasks > 0 && numTasks <= 0xffff);
+
+		busy.store(true);
+		if (!active.load())
+		{
+			busy.store(false, std::memory_order_release);
+			return false;
+		}
+
+		job = [](void* context, int index) { (*static_cast<Task*>(context))(index); };
+		jobContext = &task;
+		remaining.store(numTasks, std::memory_order_relaxed);
+
+		const auto generation = ++currentGeneration;
+		work.store(pack(generation, numTasks, 0), std::memory_order_release);
+
+		claimAndRun(generation);
+
+		for (int spins = 0; remaining.load(std::memory_order_acquire) > 0; ++spins)
+		{
+			if (spins > maxJoinSpins)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				pause();
+			}
+		}
+
+		busy.store(false, std::memory_order_release);
+		return true;
+	}
+private:
+	//with the pause hint each spin is tens of cycles, so this is still a few blocks' worth of waiting on a fast machine
+	static constexpr int maxJoinSpins = 4000;
+	static constexpr int maxIdleSpins = 2000;
+	static constexpr int maxIdleYields = 2000;
+	static constexpr int idlePollMs = 1;
+
+	struct Worker : juce::Thread
+	{
+		Worker(BandWorkers& owner, int index);
+		void run() override;
+
+		BandWorkers& owner;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	//the handshake between tryRun() and prepare(), both sides sequentially consistent
+	std::atomic<bool> active{ false };
+	std::atomic<bool> busy{ false };
+
+	//generation in the top 32 bits, then the task count and the next task in 16 bits each
+	std::atomic<uint64_t> work{ 0 };
+	std::atomic<int> remaining{ 0 };
+	uint32_t currentGeneration{ 0 };
+
+	//only written while no task of the previous job can still be running
+	void (*job)(void*, int) { nullptr };
+	void* jobContext{ nullptr };
+
+	static uint64_t pack(uint32_t generation, int numTasks, int next) noexcept
+	{
+		return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(numTasks) << 16) | static_cast<uint64_t>(next);
+	}
+
+	static uint32_t getGeneration(uint64_t word) noexcept { return static_cast<uint32_t>(word >> 32); }
+
+	//tells the core this is a spin-wait, so it backs off the memory bus and leaves the pipeline to its hyper-thread sibling
+	static void pause() noexcept
+	{
+	   #if JUCE_INTEL
+		_mm_pause();
+	   #elif JUCE_ARM && JUCE_MSVC
+		__yield();
+	   #elif JUCE_ARM
+		__asm__ __volatile__("yield");
+	   #endif
+	}
+
+	void claimAndRun(uint32_t generation) noexcept;
+};
@@ -0,0 +1,454 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 17 Oct 2026 11:02:37am
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterRamp.h"
+
+/*
+	Cascade of Linkwitz-Riley splits: split k separates band k from everything above it,
+	and band k then runs through the allpasses of every split above it so all bands stay in phase.
+	For three bands that is the old LP1/HP1 -> AP2 and LP2/HP2 layout.
+
+	The input is read once and every band is written in the same sample loop.
+	Each split shares its first TPT section between the lowpass and the highpass (highpass = allpass - lowpass),
+	and all the state for one channel sits next to each other. The state for the largest tree is laid out
+	in prepare(), so changing the band count afterwards never allocates.
+
+	With SIMD available, groups of 2, 4 or 8 channels run in lockstep, one channel per register lane.
+	The group size is chosen per block from the channel count; a leftover single channel runs scalar.
+*/
+template<typename SampleType, size_t MaxBands>
+struct MultiBandCrossover
+{
+	static constexpr size_t maxSplits = MaxBands - 1;
+	static constexpr size_t maxAllpasses = maxSplits * (maxSplits - 1) / 2;
+
+	using BandBlocks = std::array<juce::dsp::AudioBlock<SampleType>, MaxBands>;
+
+	void prepare(const juce::dsp::ProcessSpec& spec)
+	{
+		sampleRate = spec.sampleRate;
+		state.resize(spec.numChannels);
+
+		for (auto& cutoff : cutoffs)
+		{
+			cutoff.prepare(sampleRate, rampLengthSeconds);
+		}
+
+		reset();
+	}
+
+	void reset()
+	{
+		std::fill(state.begin(), state.end(), ChannelState{});
+
+		for (size_t i = 0; i < maxSplits; ++i)
+		{
+			cutoffs[i].snapToTarget();
+			updateCoefficients(i);
+		}
+	}
+
+	void setNumBands(int newNumBands)
+	{
+		jassert(newNumBands >= 2 && newNumBands <= static_cast<int>(MaxBands));
+
+		auto newNumSplits = static_cast<size_t>(newNumBands - 1);
+		if (newNumSplits != numSplits)
+		{
+			//the allpasses get reassigned to different bands, so the old state is meaningless
+			numSplits = newNumSplits;
+			reset();
+		}
+	}
+
+	int getNumBands() const noexcept { return static_cast<int>(numSplits + 1); }
+
+	void setCrossoverFrequency(size_t index, SampleType newFreq)
+	{
+		jassert(index < maxSplits);
+		jassert(newFreq > SampleType(0));
+
+		if (newFreq == cutoffs[index].getTarget())
+		{
+			return;
+		}
+
+		//nothing to glide from the very first time
+		if (cutoffs[index].getTarget() <= SampleType(0))
+		{
+			cutoffs[index].snapTo(newFreq);
+			updateCoefficients(index);
+			return;
+		}
+
+		cutoffs[index].setTarget(newFreq);
+	}
+
+	void process(const juce::dsp::AudioBlock<const SampleType>& input, const BandBlocks& bands) noexcept
+	{
+		const auto numSamples = input.getNumSamples();
+
+		auto smoothing = false;
+		for (size_t split = 0; split < numSplits; ++split)
+		{
+			smoothing = smoothing || cutoffs[split].isSmoothing();
+		}
+
+		if (!smoothing)
+		{
+			processRange(input, bands, 0, numSamples);
+			return;
+		}
+
+		//gliding cutoffs get new coefficients every controlInterval samples, tan() per sample isn't worth it
+		for (size_t start = 0; start < numSamples; start += controlInterval)
+		{
+			auto length = juce::jmin(controlInterval, numSamples - start);
+
+			for (size_t split = 0; split < numSplits; ++split)
+			{
+				if (cutoffs[split].isSmoothing())
+				{
+					cutoffs[split].advance(static_cast<int>(length));
+					updateCoefficients(split);
+				}
+			}
+
+			processRange(input, bands, start, length);
+		}
+	}
+private:
+	template<typename V>
+	struct CoefficientsT
+	{
+		V g{}, h{}, r2{}, r2PlusG{};
+	};
+
+	//one LR4 split: a shared TPT section followed by a second one on the lowpass
+	template<typename V>
+	struct SplitStateT
+	{
+		V s1{}, s2{}, s3{}, s4{};
+	};
+
+	template<typename V>
+	struct AllpassStateT
+	{
+		V s1{}, s2{};
+	};
+
+	template<typename V>
+	struct ChannelStateT
+	{
+		std::array<SplitStateT<V>, maxSplits> splits{};
+		std::array<AllpassStateT<V>, juce::jmax(maxAllpasses, size_t(1))> allpasses{};
+	};
+
+	void processRange(const juce::dsp::AudioBlock<const SampleType>& input, const BandBlocks& bands, size_t startSample, size_t numSamples) noexcept
+	{
+		const auto numChannels = input.getNumChannels();
+		jassert(numChannels <= state.size());
+
+		for (size_t band = 0; band <= numSplits; ++band)
+		{
+			jassert(bands[band].getNumChannels() == numChannels);
+			jassert(bands[band].getNumSamples() == input.getNumSamples());
+		}
+
+		size_t ch = 0;
+
+#if JUCE_USE_SIMD
+		//channels run in lockstep across SIMD lanes, the group size is picked from however many are left
+		while (numChannels - ch >= 2)
+		{
+			auto remaining = numChannels - ch;
+
+			if (remaining == 2)
+			{
+				processLanes<2>(input, bands, ch, remaining, startSample, numSamples);
+			}
+			else if (remaining <= 4)
+			{
+				processLanes<4>(input, bands, ch, remaining, startSample, numSamples);
+			}
+			else
+			{
+				remaining = juce::jmin(remaining, size_t(8));
+				processLanes<8>(input, bands, ch, remaining, startSample, numSamples);
+			}
+
+			ch += remaining;
+		}
+#endif
+
+		for (; ch < numChannels; ++ch)
+		{
+			processChannel(input, bands, ch, startSample, numSamples);
+		}
+	}
+
+	void processChannel(const juce::dsp::AudioBlock<const SampleType>& input, const BandBlocks& bands, size_t ch, size_t startSample, size_t numSamples) noexcept
+	{
+		std::array<SampleType*, MaxBands> outputs;
+		for (size_t band = 0; band <= numSplits; ++band)
+		{
+			outputs[band] = bands[band].getChannelPointer(ch) + startSample;
+		}
+
+		auto* in = input.getChannelPointer(ch) + startSample;
+		auto s = state[ch];
+
+		for (size_t i = 0; i < numSamples; ++i)
+		{
+			processSample(in[i], coefficients, s, [&outputs, i](size_t band, SampleType value) { outputs[band][i] = value; });
+		}
+
+		state[ch] = s;
+	}
+
+	//runs every split and allpass for one input sample, handing each band's output to write
+	template<typename V, typename Writer>
+	void processSample(V rest, const std::array<CoefficientsT<V>, maxSplits>& c, ChannelStateT<V>& s, Writer&& write) const noexcept
+	{
+		auto allpassIndex = size_t(0);
+
+		for (size_t split = 0; split < numSplits; ++split)
+		{
+			V band, above;
+			processSplit(rest, c[split], s.splits[split], band, above);
+
+			for (auto next = split + 1; next < numSplits; ++next)
+			{
+				band = processAllpass(band, c[next], s.allpasses[allpassIndex++]);
+			}
+
+			write(split, band);
+			rest = above;
+		}
+
+		write(numSplits, rest);
+	}
+
+	//walks two channel states field by field, for moving state between scalar channels and SIMD lanes
+	template<typename A, typename B, typename Fn>
+	static void forEachStateValue(A& a, B& b, Fn&& fn) noexcept
+	{
+		for (size_t k = 0; k < maxSplits; ++k)
+		{
+			fn(a.splits[k].s1, b.splits[k].s1);
+			fn(a.splits[k].s2, b.splits[k].s2);
+			fn(a.splits[k].s3, b.splits[k].s3);
+			fn(a.splits[k].s4, b.splits[k].s4);
+		}
+
+		for (size_t k = 0; k < a.allpasses.size(); ++k)
+		{
+			fn(a.allpasses[k].s1, b.allpasses[k].s1);
+			fn(a.allpasses[k].s2, b.allpasses[k].s2);
+		}
+	}
+
+#if JUCE_USE_SIMD
+	using Register = juce::dsp::SIMDRegister<SampleType>;
+
+	//NumLanes channels side by side, in as many native registers as that takes
+	template<size_t NumLanes>
+	struct Lanes
+	{
+		static constexpr size_t width = Register::size();
+		static constexpr size_t numRegisters = (NumLanes + width - 1) / width;
+		static constexpr size_t paddedSize = numRegisters * width;
+
+		std::array<Register, numRegisters> r;
+
+		static Lanes expand(SampleType value) noexcept
+		{
+			Lanes l;
+			for (auto& reg : l.r)
+				reg = Register::expand(value);
+			return l;
+		}
+
+		static Lanes fromRawArray(const SampleType* values) noexcept
+		{
+			Lanes l;
+			for (size_t i = 0; i < numRegisters; ++i)
+				l.r[i] = Register::fromRawArray(values + i * width);
+			return l;
+		}
+
+		void copyToRawArray(SampleType* values) const noexcept
+		{
+			for (size_t i = 0; i < numRegisters; ++i)
+				r[i].copyToRawArray(values + i * width);
+		}
+
+		void set(size_t lane, SampleType value) noexcept { r[lane / width].set(lane % width, value); }
+		SampleType get(size_t lane) const noexcept { return r[lane / width].get(lane % width); }
+
+		Lanes operator+(const Lanes& other) const noexcept
+		{
+			Lanes l;
+			for (size_t i = 0; i < numRegisters; ++i)
+				l.r[i] = r[i] + other.r[i];
+			return l;
+		}
+
+		Lanes operator-(const Lanes& other) const noexcept
+		{
+			Lanes l;
+			for (size_t i = 0; i < numRegisters; ++i)
+				l.r[i] = r[i] - other.r[i];
+			return l;
+		}
+
+		Lanes operator*(const Lanes& other) const noexcept
+		{
+			Lanes l;
+			for (size_t i = 0; i < numRegisters; ++i)
+				l.r[i] = r[i] * other.r[i];
+			return l;
+		}
+	};
+
+	template<size_t NumLanes>
+	void processLanes(const juce::dsp::AudioBlock<const SampleType>& input, const BandBlocks& bands,
+		size_t firstChannel, size_t numActive, size_t startSample, size_t numSamples) noexcept
+	{
+		using V = Lanes<NumLanes>;
+		jassert(numActive <= NumLanes);
+
+		std::array<CoefficientsT<V>, maxSplits> c;
+		for (size_t split = 0; split < numSplits; ++split)
+		{
+			c[split] = { V::expand(coefficients[split].g), V::expand(coefficients[split].h),
+				V::expand(coefficients[split].r2), V::expand(coefficients[split].r2PlusG) };
+		}
+
+		//the channels' scalar state moves into the lanes for the block and back out afterwards
+		ChannelStateT<V> s{};
+		for (size_t lane = 0; lane < numActive; ++lane)
+		{
+			forEachStateValue(state[firstChannel + lane], s, [lane](SampleType& value, V& lanes) { lanes.set(lane, value); });
+		}
+
+		std::array<const SampleType*, NumLanes> in{};
+		std::array<std::array<SampleType*, NumLanes>, MaxBands> outputs{};
+		for (size_t lane = 0; lane < numActive; ++lane)
+		{
+			in[lane] = input.getChannelPointer(firstChannel + lane) + startSample;
+			for (size_t band = 0; band <= numSplits; ++band)
+			{
+				outputs[band][lane] = bands[band].getChannelPointer(firstChannel + lane) + startSample;
+			}
+		}
+
+		//unused lanes stay at zero so they never grow anything odd
+		alignas(Register::SIMDRegisterSize) std::array<SampleType, V::paddedSize> inputFrame{};
+		alignas(Register::SIMDRegisterSize) std::array<SampleType, V::paddedSize> outputFrame{};
+
+		for (size_t i = 0; i < numSamples; ++i)
+		{
+			for (size_t lane = 0; lane < numActive; ++lane)
+			{
+				inputFrame[lane] = in[lane][i];
+			}
+
+			processSample(V::fromRawArray(inputFrame.data()), c, s, [&](size_t band, const V& value)
+			{
+				value.copyToRawArray(outputFrame.data());
+				for (size_t lane = 0; lane < numActive; ++lane)
+				{
+					outputs[band][lane][i] = outputFrame[lane];
+				}
+			});
+		}
+
+		for (size_t lane = 0; lane < numActive; ++lane)
+		{
+			forEachStateValue(state[firstChannel + lane], s, [lane](SampleType& value, V& lanes) { value = lanes.get(lane); });
+		}
+	}
+#endif
+
+	using Coefficients = CoefficientsT<SampleType>;
+	using ChannelState = ChannelStateT<SampleType>;
+
+	static constexpr SampleType R2 = SampleType(1.4142135623730951);
+	static constexpr double rampLengthSeconds{ 0.05 };
+	static constexpr size_t controlInterval{ 32 };
+
+	std::vector<ChannelState> state;
+	std::array<Coefficients, maxSplits> coefficients{};
+
+	//cutoffs glide in ratio rather than in Hz so a sweep sounds even across the range
+	std::array<ParameterRamp<SampleType, juce::ValueSmoothingTypes::Multiplicative>, maxSplits> cutoffs;
+
+	size_t numSplits{ 2 };
+	double sampleRate{ 44100.0 };
+
+	Coefficients makeCoefficients(SampleType cutoff) const
+	{
+		Coefficients c;
+		c.g = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate));
+		c.h = SampleType(1) / (SampleType(1) + R2 * c.g + c.g * c.g);
+		c.r2 = R2;
+		c.r2PlusG = R2 + c.g;
+		return c;
+	}
+
+	void updateCoefficients(size_t index)
+	{
+		if (cutoffs[index].getCurrent() > SampleType(0))
+		{
+			coefficients[index] = makeCoefficients(cutoffs[index].getCurrent());
+		}
+	}
+
+	//V is either one sample or a set of SIMD lanes, the maths is the same
+	template<typename V>
+	static V processAllpass(V x, const CoefficientsT<V>& c, AllpassStateT<V>& s) noexcept
+	{
+		auto yH = (x - c.r2PlusG * s.s1 - s.s2) * c.h;
+
+		auto yB = c.g * yH + s.s1;
+		s.s1 = c.g * yH + yB;
+
+		auto yL = c.g * yB + s.s2;
+		s.s2 = c.g * yB + yL;
+
+		return yL - c.r2 * yB + yH;
+	}
+
+	template<typename V>
+	static void processSplit(V x, const CoefficientsT<V>& c, SplitStateT<V>& s, V& outputLow, V& outputHigh) noexcept
+	{
+		auto yH = (x - c.r2PlusG * s.s1 - s.s2) * c.h;
+
+		auto yB = c.g * yH + s.s1;
+		s.s1 = c.g * yH + yB;
+
+		auto yL = c.g * yB + s.s2;
+		s.s2 = c.g * yB + yL;
+
+		auto yH2 = (yL - c.r2PlusG * s.s3 - s.s4) * c.h;
+
+		auto yB2 = c.g * yH2 + s.s3;
+		s.s3 = c.g * yH2 + yB2;
+
+		auto yL2 = c.g * yB2 + s.s4;
+		s.s4 = c.g * yB2 + yL2;
+
+		outputLow = yL2;
+		outputHigh = yL - c.r2 * yB + yH - yL2;
+	}
+};
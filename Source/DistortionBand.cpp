@@ -10,10 +10,178 @@
 #include "DistortionBand.h"
 #include "Params.h"
 
+template<typename SampleType>
+void DistortionBand<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	auto maxLatency = 0;
+	for (size_t i = 0; i < oversamplers.size(); ++i)
+	{
+		auto& oversampler = oversamplers[i];
+		oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels,
+			i + 1,
+			juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR,
+			true,
+			true);
+		oversampler->setUsingIntegerLatency(true);
+		oversampler->initProcessing(spec.maximumBlockSize);
+		maxLatency = juce::jmax(maxLatency, juce::roundToInt(oversampler->getLatencyInSamples()));
+	}
 
-void prepare(const juce::dsp::ProcessSpec& spec);
+	distortionKernel.prepare(spec);
 
-void process(const juce::dsp::ProcessContextReplacing<float>& context);
+	//one more for the ADAA delay
+	latencyCompensation.setMaximumDelayInSamples(maxLatency + 1);
+	latencyCompensation.prepare(spec);
+	compensationDelay = 0.0;
+}
 
-void updateDistortionSettings();
+template<typename SampleType>
+void DistortionBand<SampleType>::reset()
+{
+	distortionKernel.reset();
+	for (auto& oversampler : oversamplers)
+	{
+		if (oversampler != nullptr)
+		{
+			oversampler->reset();
+		}
+	}
+	latencyCompensation.reset();
+}
 
+template<typename SampleType>
+void DistortionBand<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+{
+	auto* oversampler = getActiveOversampler();
+
+	//the gain ramps keep moving while bypassed so they don't jump when the band comes back
+	distortionKernel.advance(static_cast<int>(context.getOutputBlock().getNumSamples()));
+
+	//bypassed bands skip the up/down sampling entirely and only get delayed to line up with the others
+	if (!bypassed)
+	{
+		if (oversampler != nullptr)
+		{
+			auto& block = context.getOutputBlock();
+			auto oversampledBlock = oversampler->processSamplesUp(block);
+			distortionKernel.process(juce::dsp::ProcessContextReplacing<SampleType>(oversampledBlock));
+			oversampler->processSamplesDown(block);
+		}
+		else
+		{
+			distortionKernel.process(context);
+		}
+	}
+
+	auto delay = bypassed ? compensationDelay + getProcessingLatency() : compensationDelay;
+	if (delay > 0.0)
+	{
+		latencyCompensation.setDelay(static_cast<SampleType>(delay));
+		latencyCompensation.process(context);
+	}
+}
+
+template<typename SampleType>
+void DistortionBand<SampleType>::updateDistortionSettings(const Params::BandSettings& settings)
+{
+	//the dB conversions and ramp retargeting are skipped for anything that hasn't moved
+	if (settings.inputGainInDecibels != inputGainInDecibels)
+	{
+		inputGainInDecibels = settings.inputGainInDecibels;
+		distortionKernel.setInputGainDecibels(inputGainInDecibels);
+	}
+
+	if (settings.drive != drive)
+	{
+		drive = settings.drive;
+		distortionKernel.setDrive(juce::Decibels::decibelsToGain(drive));
+	}
+
+	if (settings.outputGainInDecibels != outputGainInDecibels)
+	{
+		outputGainInDecibels = settings.outputGainInDecibels;
+		distortionKernel.setOutputGainDecibels(outputGainInDecibels);
+	}
+
+	auto newShape = static_cast<Shapers::Shape>(settings.shape);
+	if (newShape != shape)
+	{
+		shape = newShape;
+		distortionKernel.setShape(shape);
+	}
+
+	if (settings.sideDrive != sideDrive)
+	{
+		sideDrive = settings.sideDrive;
+		distortionKernel.setSideDrive(juce::Decibels::decibelsToGain(sideDrive));
+	}
+
+	//the parameter's choice index goes straight to the kernel
+	static_assert(static_cast<int>(Shapers::StereoMode::mid) == static_cast<int>(Params::StereoMode::mid)
+		&& static_cast<int>(Shapers::StereoMode::side) == static_cast<int>(Params::StereoMode::side)
+		&& static_cast<int>(Shapers::StereoMode::midSide) == static_cast<int>(Params::StereoMode::midSide));
+	auto newStereoMode = static_cast<Shapers::StereoMode>(settings.stereoMode);
+	if (newStereoMode != stereoMode)
+	{
+		stereoMode = newStereoMode;
+		distortionKernel.setStereoMode(stereoMode);
+	}
+
+	bypassed = settings.bypassed;
+	requestedOversampling = settings.oversampling;
+}
+
+template<typename SampleType>
+double DistortionBand<SampleType>::updateOversampling()
+{
+	auto newFactor = static_cast<OversamplingFactor>(juce::jlimit(0, maxOversamplingStages, requestedOversampling));
+
+	if (newFactor != oversamplingFactor)
+	{
+		oversamplingFactor = newFactor;
+		if (auto* oversampler = getActiveOversampler())
+		{
+			oversampler->reset();
+		}
+	}
+
+	return getProcessingLatency();
+}
+
+template<typename SampleType>
+void DistortionBand<SampleType>::setLatencyCompensation(double totalLatencyInSamples)
+{
+	auto newDelay = juce::jmax(0.0, totalLatencyInSamples - getProcessingLatency());
+	if (newDelay != compensationDelay)
+	{
+		compensationDelay = newDelay;
+		latencyCompensation.reset();
+	}
+}
+
+template<typename SampleType>
+juce::dsp::Oversampling<SampleType>* DistortionBand<SampleType>::getActiveOversampler() const
+{
+	auto stages = static_cast<int>(oversamplingFactor);
+	if (stages == 0)
+	{
+		return nullptr;
+	}
+
+	return oversamplers[stages - 1].get();
+}
+
+template<typename SampleType>
+double DistortionBand<SampleType>::getProcessingLatency() const
+{
+	//the kernel's delay is counted at the rate it runs at, which is the oversampled one
+	if (auto* oversampler = getActiveOversampler())
+	{
+		return juce::roundToInt(oversampler->getLatencyInSamples()) + distortionKernel.getLatencyInSamples() / static_cast<double>(oversampler->getOversamplingFactor());
+	}
+
+	return distortionKernel.getLatencyInSamples();
+}
+
+template struct DistortionBand<float>;
+template struct DistortionBand<double>;
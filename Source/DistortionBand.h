@@ -10,85 +10,59 @@
 #pragma once
 #include <JuceHeader.h>
 #include "Params.h"
+#include "Waveshapers.h"
+template<typename SampleType>
 struct DistortionBand
 {
 public:
-	enum class BandFreq
+	enum class OversamplingFactor
 	{
-		lowBand,
-		midBand,
-		highBand,
+		off,
+		x2,
+		x4,
+		x8,
 	};
 
-	DistortionBand(juce::AudioProcessorValueTreeState* p_apvts, BandFreq bandFreq);
+	void prepare(const juce::dsp::ProcessSpec& spec);
 
+	void reset();
 
-	void prepare(const juce::dsp::ProcessSpec& spec)
-	{
-		processorChain.prepare(spec);
-	}
+	void process(const juce::dsp::ProcessContextReplacing<SampleType>& context);
 
-	void process(const juce::dsp::ProcessContextReplacing<float>& context)
-	{
-		updateDistortionSettings();
-		if (!bypassed)
-		{
-			processorChain.process(context);
-		}
-	}
+	// Only the settings that differ from the last call reach the kernel.
+	void updateDistortionSettings(const Params::BandSettings& settings);
+
+	void setChannelLink(bool shouldLink) { distortionKernel.setChannelLink(shouldLink); }
+
+	// Null evaluates the band's curve directly.
+	void setShaperTable(const Shapers::Table* table) { distortionKernel.setTable(table); }
+
+	void setShaperMode(Shapers::Mode mode) { distortionKernel.setMode(mode); }
+
+	// Applies the band's oversampling choice and returns the latency it adds at the host rate.
+	// ADAA adds half a sample or one at the rate the curve runs at, so this can be fractional.
+	double updateOversampling();
+
+	// Delays the band so its output lines up with the slowest band in the processor.
+	void setLatencyCompensation(double totalLatencyInSamples);
 private:
-	juce::AudioProcessorValueTreeState* p_apvts;
-	BandFreq bandFreq;
-	juce::dsp::ProcessorChain<juce::dsp::Gain<float>, WaveShaper, juce::dsp::Gain<float>> processorChain;
+	DistortionKernel<SampleType> distortionKernel;
 	float drive{ 0.f };
+	Shapers::Shape shape{ Shapers::Shape::hardClip };
+	Shapers::StereoMode stereoMode{ Shapers::StereoMode::stereo };
+	float sideDrive{ 0.f };
 	float inputGainInDecibels{ 0.0f }, outputGainInDecibels{ 0.0f };
 	bool bypassed{ false };
-	enum
-	{
-		preGainIndex,
-		waveShaperIndex,
-		postGainIndex,
-	};
-	void updateDistortionSettings()
-	{
-		
-		using namespace Params;
-		const auto& params = GetParams();
-		switch (bandFreq)
-		{
-		case DistortionBand::BandFreq::lowBand:
-			drive = p_apvts->getRawParameterValue(params.at(Names::Distortion_Low_Band))->load();
-			inputGainInDecibels = p_apvts->getRawParameterValue(params.at(Names::InputGain_Low_Band))->load();
-			outputGainInDecibels = p_apvts->getRawParameterValue(params.at(Names::OutputGain_Low_Band))->load();
-			bypassed = p_apvts->getRawParameterValue(params.at(Names::Bypassed_Low_Band))->load();
-			break;
-		case DistortionBand::BandFreq::midBand:
-			drive = p_apvts->getRawParameterValue(params.at(Names::Distortion_Mid_Band))->load();
-			inputGainInDecibels = p_apvts->getRawParameterValue(params.at(Names::InputGain_Mid_Band))->load();
-			outputGainInDecibels = p_apvts->getRawParameterValue(params.at(Names::OutputGain_Mid_Band))->load();
-			bypassed = p_apvts->getRawParameterValue(params.at(Names::Bypassed_Mid_Band))->load();
-			break;
-		case DistortionBand::BandFreq::highBand:
-			drive = p_apvts->getRawParameterValue(params.at(Names::Distortion_High_Band))->load();
-			inputGainInDecibels = p_apvts->getRawParameterValue(params.at(Names::InputGain_High_Band))->load();
-			outputGainInDecibels = p_apvts->getRawParameterValue(params.at(Names::OutputGain_High_Band))->load();
-			bypassed = p_apvts->getRawParameterValue(params.at(Names::Bypassed_High_Band))->load();
-			break;
-		default:
-			break;
-		}
 
-		auto& preGain = processorChain.template get<preGainIndex>();
-		preGain.setGainDecibels(inputGainInDecibels);
-		auto& postGain = processorChain.template get<postGainIndex>();
-		postGain.setGainDecibels(outputGainInDecibels);
+	static constexpr int maxOversamplingStages = 3;
+	std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, maxOversamplingStages> oversamplers;
+	OversamplingFactor oversamplingFactor{ OversamplingFactor::off };
+	int requestedOversampling{ 0 };
+
+	//linear, so the half samples ADAA leaves over are averaged the same way ADAA averages a quiet signal
+	juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::Linear> latencyCompensation;
+	double compensationDelay{ 0.0 };
 
-		float clipping{ 0.5f };
-		float driveInGain{ juce::Decibels::decibelsToGain(drive) };
-		auto& waveshaper = processorChain.template get<waveShaperIndex>();
-		waveshaper.functionToUse = [driveInGain, clipping](float x)
-		{
-			return juce::jlimit(float(-clipping), float(clipping), x * (driveInGain / 10)) * 1 / clipping;
-		};
-	}
+	juce::dsp::Oversampling<SampleType>* getActiveOversampler() const;
+	double getProcessingLatency() const;
 };
\ No newline at end of file
@@ -17,11 +17,13 @@ DistortionBandControls::DistortionBandControls(juce::AudioProcessorValueTreeStat
 	apvts(apv),
 	inputGainSlider(nullptr, "dB", "INPUT"),
 	distortionSlider(nullptr, "%", "DRIVE"),
+	sideDistortionSlider(nullptr, "%", "SIDE"),
 	outputGainSlider(nullptr, "dB", "OUTPUT")
 {
 	addAndMakeVisible(inputGainSlider);
 	addAndMakeVisible(outputGainSlider);
 	addAndMakeVisible(distortionSlider);
+	addAndMakeVisible(sideDistortionSlider);
 
 	bypassButton.addListener(this);
 
@@ -31,21 +33,15 @@ DistortionBandControls::DistortionBandControls(juce::AudioProcessorValueTreeStat
 
 	addAndMakeVisible(bypassButton);
 
-	lowBandButton.setName("Low");
-	lowBandButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::limegreen);
-	lowBandButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+	oversamplingBox.addItemList(Params::GetOversamplingChoices(), 1);
+	addAndMakeVisible(oversamplingBox);
 
-	midBandButton.setName("Mid");
-	midBandButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::limegreen);
-	midBandButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+	shapeBox.addItemList(Params::GetShapeChoices(), 1);
+	addAndMakeVisible(shapeBox);
 
-	highBandButton.setName("High");
-	highBandButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::limegreen);
-	highBandButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-
-	lowBandButton.setRadioGroupId(1);
-	midBandButton.setRadioGroupId(1);
-	highBandButton.setRadioGroupId(1);
+	stereoModeBox.addItemList(Params::GetStereoModeChoices(), 1);
+	stereoModeBox.onChange = [this]() { updateSliderEnablements(); };
+	addAndMakeVisible(stereoModeBox);
 
 	auto buttonSwitcher = [safePtr = this->safePtr]()
 	{
@@ -55,19 +51,27 @@ DistortionBandControls::DistortionBandControls(juce::AudioProcessorValueTreeStat
 		}
 	};
 
-	lowBandButton.onClick = buttonSwitcher;
-	midBandButton.onClick = buttonSwitcher;
-	highBandButton.onClick = buttonSwitcher;
+	for (auto& bandButton : bandButtons)
+	{
+		bandButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::limegreen);
+		bandButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+		bandButton.setRadioGroupId(1);
+		bandButton.onClick = buttonSwitcher;
+		addChildComponent(bandButton);
+	}
+
+	bandButtons[0].setToggleState(true, juce::NotificationType::dontSendNotification);
 
-	lowBandButton.setToggleState(true, juce::NotificationType::dontSendNotification);
+	auto& bandCountParam = getParam(apvts, Params::ParamIDs, Params::Names::Band_Count);
+	bandCountAttachment = std::make_unique<juce::ParameterAttachment>(bandCountParam, [this](float value)
+	{
+		updateBandCount(juce::roundToInt(value));
+	});
+	bandCountAttachment->sendInitialUpdate();
 
 	updateAttachments();
 	updateSliderEnablements();
 	updateBandSelectButtonStates();
-
-	addAndMakeVisible(lowBandButton);
-	addAndMakeVisible(midBandButton);
-	addAndMakeVisible(highBandButton);
 }
 
 DistortionBandControls::~DistortionBandControls()
@@ -98,8 +102,13 @@ void DistortionBandControls::resized()
 		return flexBox;
 	};
 
-	auto bandButtonControlBox = createBandButtonControlBox({ &bypassButton });
-	auto bandSelectControlBox = createBandButtonControlBox({ &lowBandButton, &midBandButton, &highBandButton });
+	auto bandButtonControlBox = createBandButtonControlBox({ &bypassButton, &shapeBox, &stereoModeBox, &oversamplingBox });
+	std::vector<Component*> visibleBandButtons;
+	for (int i = 0; i < numBands; ++i)
+	{
+		visibleBandButtons.push_back(&bandButtons[static_cast<size_t>(i)]);
+	}
+	auto bandSelectControlBox = createBandButtonControlBox(visibleBandButtons);
 	auto spacer = FlexItem().withWidth(4);
 
 	FlexBox flexBox;
@@ -113,9 +122,11 @@ void DistortionBandControls::resized()
 	flexBox.items.add(spacer);
 	flexBox.items.add(FlexItem(distortionSlider).withFlex(1.f));
 	flexBox.items.add(spacer);
+	flexBox.items.add(FlexItem(sideDistortionSlider).withFlex(1.f));
+	flexBox.items.add(spacer);
 	flexBox.items.add(FlexItem(outputGainSlider).withFlex(1.f));
 	flexBox.items.add(spacer);
-	flexBox.items.add(FlexItem(bandButtonControlBox).withWidth(30));
+	flexBox.items.add(FlexItem(bandButtonControlBox).withWidth(75));
 	flexBox.performLayout(bounds);
 }
 
@@ -164,29 +175,53 @@ void DistortionBandControls::updateBandSelectButtonStates()
 {
 	using namespace Params;
 
-	std::vector<std::array<Names, 1>> paramsToCheck
+	for (int i = 0; i < numBands; ++i)
 	{
-		{Names::Bypassed_Low_Band},
-		{ Names::Bypassed_Mid_Band },
-		{ Names::Bypassed_High_Band },
-	};
-	const auto& params = GetParams();
-	auto paramHelper = [&params, this](const auto& name)
+		auto& bandButton = bandButtons[static_cast<size_t>(i)];
+
+		if (auto* bypassed = dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts, ParamIDs, BandParams[static_cast<size_t>(i)].bypassed));
+			bypassed->get())
+		{
+			refreshBandButtonColors(bandButton, bypassButton);
+		}
+	}
+}
+
+void DistortionBandControls::updateBandCount(int newNumBands)
+{
+	numBands = juce::jlimit(Params::MinBands, Params::MaxBands, newNumBands);
+
+	for (int i = 0; i < Params::MaxBands; ++i)
 	{
-		return dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts,params,name));
-	};
-	for (size_t i = 0; i < paramsToCheck.size(); ++i)
+		auto& bandButton = bandButtons[static_cast<size_t>(i)];
+		bandButton.setName(Params::GetBandName(i, numBands));
+		bandButton.setVisible(i < numBands);
+		bandButton.repaint();
+	}
+
+	//the selected band may just have disappeared
+	if (getSelectedBand() >= numBands)
 	{
-		auto& list = paramsToCheck[i];
+		resetActiveBandColors();
+		bandButtons[static_cast<size_t>(numBands - 1)].setToggleState(true, juce::NotificationType::dontSendNotification);
+		updateAttachments();
+		updateSliderEnablements();
+	}
 
-		auto* bandButton = (i == 0) ? &lowBandButton : i == 1 ? &midBandButton : &highBandButton;
+	resized();
+}
 
-		if (auto * bypassed = paramHelper(list[0]);
-			bypassed->get())
+int DistortionBandControls::getSelectedBand() const
+{
+	for (size_t i = 0; i < bandButtons.size(); ++i)
+	{
+		if (bandButtons[i].getToggleState())
 		{
-			refreshBandButtonColors(*bandButton, bypassButton);
+			return static_cast<int>(i);
 		}
 	}
+
+	return 0;
 }
 
 void DistortionBandControls::updateSliderEnablements()
@@ -196,115 +231,62 @@ void DistortionBandControls::updateSliderEnablements()
 	distortionSlider.setEnabled(!disabled);
 	outputGainSlider.setEnabled(!disabled);
 
+	//only M/S gives the side its own drive
+	sideDistortionSlider.setEnabled(!disabled && stereoModeBox.getSelectedItemIndex() == static_cast<int>(Params::StereoMode::midSide));
+
 }
 
 void DistortionBandControls::updateAttachments()
 {
-	enum BandType
-	{
-		Low,
-		Mid,
-		High
-	};
-
-	BandType bandType = [this]()
-	{
-		if (lowBandButton.getToggleState())
-		{
-			return BandType::Low;
-		}
-		if (midBandButton.getToggleState())
-		{
-			return BandType::Mid;
-		}
-
-		return BandType::High;
-	}();
-
 	using namespace Params;
-	std::vector<Names> names;
-
-	switch (bandType)
-	{
-	case Low:
-	{
-		names = std::vector<Names>
-		{
-			Names::InputGain_Low_Band,
-			Names::Distortion_Low_Band,
-			Names::OutputGain_Low_Band,
-			Names::Bypassed_Low_Band,
-		};
-		activeBand = &lowBandButton;
-		break;
-	}
-	case Mid:
-	{
-		names = std::vector<Names>
-		{
-			Names::InputGain_Mid_Band,
-			Names::Distortion_Mid_Band,
-			Names::OutputGain_Mid_Band,
-			Names::Bypassed_Mid_Band,
-		};
-		activeBand = &midBandButton;
+	auto band = getSelectedBand();
+	const auto& names = BandParams[static_cast<size_t>(band)];
+	activeBand = &bandButtons[static_cast<size_t>(band)];
 
-		break;
-
-	}
-	case High:
-	{
-		names = std::vector<Names>
-		{
-			Names::InputGain_High_Band,
-			Names::Distortion_High_Band,
-			Names::OutputGain_High_Band,
-			Names::Bypassed_High_Band,
-		};
-		activeBand = &highBandButton;
-
-		break;
-	}
-	}
-	enum Pos
+	auto getParamHelper = [&apvts = this->apvts](const auto& name) -> auto&
 	{
-		InputGain,
-		Distortion,
-		OutputGain,
-		Bypass
-	};
-
-	const auto& params = GetParams();
-	auto getParamHelper = [&params, &apvts = this-> apvts, &names](const auto& pos) -> auto&
-	{
-
-		return getParam(apvts, params, names.at(pos));
+		return getParam(apvts, ParamIDs, name);
 	};
 
 	inputGainSliderAttachment.reset();
 	outputGainSliderAttachment.reset();
 	distortionSliderAttachment.reset();
 	bypassButtonAttachment.reset();
+	oversamplingBoxAttachment.reset();
+	shapeBoxAttachment.reset();
+	stereoModeBoxAttachment.reset();
+	sideDistortionSliderAttachment.reset();
 
-	auto& inputGainParam = getParamHelper(Pos::InputGain);
+	auto& inputGainParam = getParamHelper(names.inputGain);
 	addLabelPairs(inputGainSlider.labels, inputGainParam, "dB");
 	inputGainSlider.changeParam(&inputGainParam);
 
-	auto& distortionParam = getParamHelper(Pos::Distortion);
+	auto& distortionParam = getParamHelper(names.distortion);
 	addLabelPairs(distortionSlider.labels, distortionParam, "%");
 	distortionSlider.changeParam(&distortionParam);
 
-	auto& outputGainParam = getParamHelper(Pos::OutputGain);
+	auto& sideDistortionParam = getParamHelper(names.sideDistortion);
+	addLabelPairs(sideDistortionSlider.labels, sideDistortionParam, "%");
+	sideDistortionSlider.changeParam(&sideDistortionParam);
+
+	auto& outputGainParam = getParamHelper(names.outputGain);
 	addLabelPairs(outputGainSlider.labels, outputGainParam, "dB");
 	outputGainSlider.changeParam(&outputGainParam);
 
-	auto makeAttachmentHelper = [&params, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider) {
-		makeAttachment(attachment, apvts, params, name, slider);
+	auto makeAttachmentHelper = [&apvts = this->apvts](auto& attachment, const auto& name, auto& slider) {
+		makeAttachment(attachment, apvts, ParamIDs, name, slider);
 	};
 
-	makeAttachmentHelper(inputGainSliderAttachment, names[Pos::InputGain], inputGainSlider);
-	makeAttachmentHelper(distortionSliderAttachment, names[Pos::Distortion], distortionSlider);
-	makeAttachmentHelper(outputGainSliderAttachment, names[Pos::OutputGain], outputGainSlider);
-	makeAttachmentHelper(bypassButtonAttachment, names[Pos::Bypass], bypassButton);
+	makeAttachmentHelper(inputGainSliderAttachment, names.inputGain, inputGainSlider);
+	makeAttachmentHelper(distortionSliderAttachment, names.distortion, distortionSlider);
+	makeAttachmentHelper(outputGainSliderAttachment, names.outputGain, outputGainSlider);
+	makeAttachmentHelper(bypassButtonAttachment, names.bypassed, bypassButton);
+	makeAttachmentHelper(oversamplingBoxAttachment, names.oversampling, oversamplingBox);
+	makeAttachmentHelper(shapeBoxAttachment, names.shape, shapeBox);
+	makeAttachmentHelper(stereoModeBoxAttachment, names.stereoMode, stereoModeBox);
+	makeAttachmentHelper(sideDistortionSliderAttachment, names.sideDistortion, sideDistortionSlider);
+
+	//the new band's stereo mode decides whether the side drive applies
+	updateSliderEnablements();
 
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
+#include "Params.h"
 struct DistortionBandControls : juce::Component, juce::Button::Listener
 {
 	DistortionBandControls(juce::AudioProcessorValueTreeState& apvts);
@@ -23,19 +24,28 @@ struct DistortionBandControls : juce::Component, juce::Button::Listener
 private:
 	juce::AudioProcessorValueTreeState& apvts;
 
-	RotarySliderWithLabels inputGainSlider, distortionSlider, outputGainSlider;
+	RotarySliderWithLabels inputGainSlider, distortionSlider, sideDistortionSlider, outputGainSlider;
 
 	using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-	std::unique_ptr<Attachment> inputGainSliderAttachment, distortionSliderAttachment, outputGainSliderAttachment;
+	std::unique_ptr<Attachment> inputGainSliderAttachment, distortionSliderAttachment, sideDistortionSliderAttachment, outputGainSliderAttachment;
 
-	juce::ToggleButton bypassButton, lowBandButton, midBandButton, highBandButton;
+	juce::ToggleButton bypassButton;
+	std::array<juce::ToggleButton, Params::MaxBands> bandButtons;
+	int numBands{ Params::DefaultBands };
+
+	std::unique_ptr<juce::ParameterAttachment> bandCountAttachment;
 
 	using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
 	std::unique_ptr<BtnAttachment> bypassButtonAttachment;
 
+	juce::ComboBox oversamplingBox, shapeBox, stereoModeBox;
+
+	using BoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+	std::unique_ptr<BoxAttachment> oversamplingBoxAttachment, shapeBoxAttachment, stereoModeBoxAttachment;
+
 	juce::Component::SafePointer<DistortionBandControls> safePtr{this};
 
-	juce::ToggleButton* activeBand = &lowBandButton;
+	juce::ToggleButton* activeBand = &bandButtons[0];
 
 	void updateAttachments();
 	void updateSliderEnablements();
@@ -45,4 +55,6 @@ private:
 	static void refreshBandButtonColors(juce::Button& band, juce::Button& colorSource);
 
 	void updateBandSelectButtonStates();
+	void updateBandCount(int newNumBands);
+	int getSelectedBand() const;
 };
@@ -20,7 +20,13 @@ struct FFTDataGenerator
     {
         const auto fftSize = getFFTSize();
 
-        fftData.assign(fftData.size(), 0);
+        //the frame is rendered straight into its fifo slot, and not at all when the reader is that far behind
+        auto* slot = fftDataFifo.acquireWriteSlot();
+        if (slot == nullptr)
+            return;
+
+        auto& fftData = *slot;
+        std::fill(fftData.begin(), fftData.end(), 0.f);
         auto* readIndex = audioData.getReadPointer(0);
         std::copy(readIndex, readIndex + fftSize, fftData.begin());
 
@@ -53,7 +59,7 @@ struct FFTDataGenerator
             fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
         }
 
-        fftDataFifo.push(fftData);
+        fftDataFifo.commitWriteSlot();
     }
 
     void changeOrder(FFTOrder newOrder)
@@ -65,19 +71,19 @@ struct FFTDataGenerator
         forwardFFT = std::make_unique<juce::dsp::FFT>(order);
         window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
 
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
+        fftDataFifo.prepare(static_cast<size_t>(fftSize) * 2);
     }
     //==============================================================================
     int getFFTSize() const { return 1 << order; }
     int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
     //==============================================================================
     bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
+
+    //reads the oldest frame in place, it stays valid until releaseFFTData()
+    const BlockType* acquireFFTData() { return fftDataFifo.acquireReadSlot(); }
+    void releaseFFTData() { fftDataFifo.releaseReadSlot(); }
 private:
     FFTOrder order;
-    BlockType fftData;
     std::unique_ptr<juce::dsp::FFT> forwardFFT;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
 
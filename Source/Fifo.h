@@ -42,10 +42,10 @@ struct Fifo
 
     bool push(const T& t)
     {
-        auto write = fifo.write(1);
-        if (write.blockSize1 > 0)
+        if (auto* slot = acquireWriteSlot())
         {
-            buffers[write.startIndex1] = t;
+            *slot = t;
+            commitWriteSlot();
             return true;
         }
 
@@ -54,16 +54,36 @@ struct Fifo
 
     bool pull(T& t)
     {
-        auto read = fifo.read(1);
-        if (read.blockSize1 > 0)
+        if (auto* slot = acquireReadSlot())
         {
-            t = buffers[read.startIndex1];
+            t = *slot;
+            releaseReadSlot();
             return true;
         }
 
         return false;
     }
 
+    //the writer fills the slot where it sits and commits it, nullptr when the fifo is full
+    T* acquireWriteSlot()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        return size1 > 0 ? &buffers[static_cast<size_t>(start1)] : nullptr;
+    }
+
+    void commitWriteSlot() { fifo.finishedWrite(1); }
+
+    //the reader may use the slot, or swap its contents out, until it releases it, nullptr when the fifo is empty
+    T* acquireReadSlot()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+        return size1 > 0 ? &buffers[static_cast<size_t>(start1)] : nullptr;
+    }
+
+    void releaseReadSlot() { fifo.finishedRead(1); }
+
     int getNumAvailableForReading() const
     {
         return fifo.getNumReady();
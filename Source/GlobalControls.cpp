@@ -21,24 +21,56 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
 		return getParam(apvts, params, name);
 	};
 
-	auto& lowMidParam = getParamHelper(Names::Low_Mid_Crossover_Freq);
-	auto& midHighParam = getParamHelper(Names::Mid_High_Crossover_Freq);
-
-	lowMidXoverSlider = std::make_unique<RSWL>(&lowMidParam, "Hz", "LOW_MID X-OVER");
-	midHighXoverSlider = std::make_unique<RSWL>(&midHighParam, "Hz", "MID_HIGH X-OVER");
-
 	auto makeAttachmentHelper = [&params, &apvts](auto& attachment, const auto& name, auto& slider) {
 		makeAttachment(attachment, apvts, params, name, slider);
 	};
 
-	makeAttachmentHelper(lowMidXoverSliderAttachment, Names::Low_Mid_Crossover_Freq, *lowMidXoverSlider);
-	makeAttachmentHelper(midHighXoverSliderAttachment, Names::Mid_High_Crossover_Freq, *midHighXoverSlider);
+	auto& bandCountParam = getParamHelper(Names::Band_Count);
+	bandCountSlider = std::make_unique<RSWL>(&bandCountParam, "", "BANDS");
+	makeAttachmentHelper(bandCountSliderAttachment, Names::Band_Count, *bandCountSlider);
+	addLabelPairs(bandCountSlider->labels, bandCountParam, "");
+	addAndMakeVisible(*bandCountSlider);
+
+	crossoverModeBox.addItemList(GetCrossoverModeChoices(), 1);
+	makeAttachmentHelper(crossoverModeBoxAttachment, Names::Crossover_Mode, crossoverModeBox);
+	addAndMakeVisible(crossoverModeBox);
+
+	shaperModeBox.addItemList(GetShaperModeChoices(), 1);
+	makeAttachmentHelper(shaperModeBoxAttachment, Names::Shaper_Mode, shaperModeBox);
+	addAndMakeVisible(shaperModeBox);
+
+	blockModeBox.addItemList(GetBlockModeChoices(), 1);
+	makeAttachmentHelper(blockModeBoxAttachment, Names::Block_Mode, blockModeBox);
+	addAndMakeVisible(blockModeBox);
 
-	addLabelPairs(lowMidXoverSlider->labels, lowMidParam, "Hz");
-	addLabelPairs(midHighXoverSlider->labels, midHighParam, "Hz");
+	channelLinkButton.setName("LINK");
+	channelLinkButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::limegreen);
+	channelLinkButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+	makeAttachmentHelper(channelLinkButtonAttachment, Names::Channel_Link, channelLinkButton);
+	addAndMakeVisible(channelLinkButton);
 
-	addAndMakeVisible(*lowMidXoverSlider);
-	addAndMakeVisible(*midHighXoverSlider);
+	parallelBandsButton.setName("MT");
+	parallelBandsButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::limegreen);
+	parallelBandsButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+	makeAttachmentHelper(parallelBandsButtonAttachment, Names::Parallel_Bands, parallelBandsButton);
+	addAndMakeVisible(parallelBandsButton);
+
+	for (size_t i = 0; i < xoverSliders.size(); ++i)
+	{
+		auto name = CrossoverParams[i];
+		auto& xoverParam = getParamHelper(name);
+
+		xoverSliders[i] = std::make_unique<RSWL>(&xoverParam, "Hz", "X-OVER " + juce::String(i + 1));
+		makeAttachmentHelper(xoverSliderAttachments[i], name, *xoverSliders[i]);
+		addLabelPairs(xoverSliders[i]->labels, xoverParam, "Hz");
+		addChildComponent(*xoverSliders[i]);
+	}
+
+	bandCountAttachment = std::make_unique<juce::ParameterAttachment>(bandCountParam, [this](float value)
+	{
+		updateBandCount(juce::roundToInt(value));
+	});
+	bandCountAttachment->sendInitialUpdate();
 }
 void GlobalControls::paint(juce::Graphics& g)
 {
@@ -58,10 +90,44 @@ void GlobalControls::resized()
 	flexBox.flexWrap = FlexBox::Wrap::noWrap;
 
 	flexBox.items.add(endCap);
-	flexBox.items.add(FlexItem(*lowMidXoverSlider).withFlex(1.f));
+	flexBox.items.add(FlexItem(*bandCountSlider).withFlex(1.f));
 	flexBox.items.add(spacer);
-	flexBox.items.add(FlexItem(*midHighXoverSlider).withFlex(1.f));
+
+	FlexBox optionsBox;
+	optionsBox.flexDirection = FlexBox::Direction::column;
+	optionsBox.justifyContent = FlexBox::JustifyContent::center;
+	optionsBox.items.add(FlexItem(crossoverModeBox).withHeight(24));
+	optionsBox.items.add(FlexItem().withHeight(4));
+	optionsBox.items.add(FlexItem(shaperModeBox).withHeight(24));
+	optionsBox.items.add(FlexItem().withHeight(4));
+	optionsBox.items.add(FlexItem(blockModeBox).withHeight(24));
+	optionsBox.items.add(FlexItem().withHeight(4));
+
+	FlexBox buttonRow;
+	buttonRow.flexDirection = FlexBox::Direction::row;
+	buttonRow.items.add(FlexItem(channelLinkButton).withFlex(1.f));
+	buttonRow.items.add(spacer);
+	buttonRow.items.add(FlexItem(parallelBandsButton).withFlex(1.f));
+	optionsBox.items.add(FlexItem(buttonRow).withHeight(24));
+	flexBox.items.add(FlexItem(optionsBox).withWidth(110));
+	for (int i = 0; i < numBands - 1; ++i)
+	{
+		flexBox.items.add(spacer);
+		flexBox.items.add(FlexItem(*xoverSliders[static_cast<size_t>(i)]).withFlex(1.f));
+	}
 	flexBox.items.add(endCap);
 
 	flexBox.performLayout(bounds);
+}
+
+void GlobalControls::updateBandCount(int newNumBands)
+{
+	numBands = juce::jlimit(Params::MinBands, Params::MaxBands, newNumBands);
+
+	for (size_t i = 0; i < xoverSliders.size(); ++i)
+	{
+		xoverSliders[i]->setVisible(static_cast<int>(i) < numBands - 1);
+	}
+
+	resized();
 }
\ No newline at end of file
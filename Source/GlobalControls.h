@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
+#include "Params.h"
 struct GlobalControls : juce::Component
 {
 	GlobalControls(juce::AudioProcessorValueTreeState& apvts);
@@ -19,8 +20,33 @@ struct GlobalControls : juce::Component
 	void resized() override;
 private:
 	using RSWL = RotarySliderWithLabels;
-	std::unique_ptr<RSWL> lowMidXoverSlider, midHighXoverSlider;
+	std::unique_ptr<RSWL> bandCountSlider;
+	std::array<std::unique_ptr<RSWL>, Params::MaxBands - 1> xoverSliders;
 
 	using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-	std::unique_ptr<Attachment> lowMidXoverSliderAttachment, midHighXoverSliderAttachment;
+	std::unique_ptr<Attachment> bandCountSliderAttachment;
+	std::array<std::unique_ptr<Attachment>, Params::MaxBands - 1> xoverSliderAttachments;
+
+	juce::ComboBox crossoverModeBox;
+	using BoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+	std::unique_ptr<BoxAttachment> crossoverModeBoxAttachment;
+
+	juce::ComboBox shaperModeBox;
+	std::unique_ptr<BoxAttachment> shaperModeBoxAttachment;
+
+	juce::ComboBox blockModeBox;
+	std::unique_ptr<BoxAttachment> blockModeBoxAttachment;
+
+	juce::ToggleButton channelLinkButton;
+	using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+	std::unique_ptr<BtnAttachment> channelLinkButtonAttachment;
+
+	juce::ToggleButton parallelBandsButton;
+	std::unique_ptr<BtnAttachment> parallelBandsButtonAttachment;
+
+	//only the crossovers in use get a slider
+	std::unique_ptr<juce::ParameterAttachment> bandCountAttachment;
+	int numBands{ Params::DefaultBands };
+
+	void updateBandCount(int newNumBands);
 };
\ No newline at end of file
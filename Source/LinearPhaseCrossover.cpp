@@ -0,0 +1,361 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.cpp
+    Created: 17 Oct 2026 1:18:52pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseCrossover.h"
+
+LinearPhaseCrossover::LinearPhaseCrossover() :
+	juce::Thread("Linear Phase Crossover")
+{
+	for (auto& frequency : requestedFrequencies)
+	{
+		frequency.store(0.f);
+	}
+}
+
+LinearPhaseCrossover::~LinearPhaseCrossover()
+{
+	stopThread(1000);
+	clearKernels();
+}
+
+void LinearPhaseCrossover::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	//the designer works with the partition layout below, so it has to be idle while that changes.
+	//updateDesigner() starts it again once linear phase is in use
+	const juce::ScopedLock lock(designerLock);
+	stopThread(1000);
+	clearKernels();
+
+	sampleRate = spec.sampleRate;
+	numPartitions = juce::jmax(1, static_cast<int>(std::ceil(sampleRate * kernelLengthSeconds / partitionSize)));
+	numTaps = numPartitions * partitionSize - 1;
+
+	state.resize(spec.numChannels);
+	for (auto& s : state)
+	{
+		s.time.assign(fftSize, 0.f);
+		s.delayLine.assign(static_cast<size_t>(numPartitions * numBins * 2), 0.f);
+		s.output.assign(static_cast<size_t>(Params::MaxBands * partitionSize), 0.f);
+	}
+
+	fftBuffer.assign(fftSize * 2, 0.f);
+	accumulator.assign(numBins * 2, 0.f);
+	fadeBuffer.assign(partitionSize, 0.f);
+
+	designedVersion = requestedVersion.load(std::memory_order_acquire);
+	notifiedVersion = designedVersion;
+	activeKernels = designKernels(designerFFT);
+
+	reset();
+}
+
+void LinearPhaseCrossover::updateDesigner()
+{
+	const juce::ScopedLock lock(designerLock);
+
+	if (!inUse.load(std::memory_order_acquire))
+	{
+		stopThread(1000);
+		return;
+	}
+
+	//a freshly started designer looks for requests before it first sleeps
+	const auto version = requestedVersion.load(std::memory_order_acquire);
+	if (!isThreadRunning())
+	{
+		startThread();
+	}
+	else if (version != notifiedVersion)
+	{
+		notify();
+	}
+
+	notifiedVersion = version;
+}
+
+void LinearPhaseCrossover::reset() noexcept
+{
+	for (auto& s : state)
+	{
+		std::fill(s.time.begin(), s.time.end(), 0.f);
+		std::fill(s.delayLine.begin(), s.delayLine.end(), 0.f);
+		std::fill(s.output.begin(), s.output.end(), 0.f);
+	}
+
+	fifoPosition = 0;
+	delayLinePosition = 0;
+}
+
+void LinearPhaseCrossover::setCrossoverFrequencies(const Frequencies& frequencies, int numBands) noexcept
+{
+	auto changed = numBands != lastNumBands;
+	for (int i = 0; i < numBands - 1; ++i)
+	{
+		changed = changed || frequencies[static_cast<size_t>(i)] != lastFrequencies[static_cast<size_t>(i)];
+	}
+
+	if (!changed)
+	{
+		return;
+	}
+
+	lastNumBands = numBands;
+	lastFrequencies = frequencies;
+
+	for (size_t i = 0; i < requestedFrequencies.size(); ++i)
+	{
+		requestedFrequencies[i].store(frequencies[i], std::memory_order_relaxed);
+	}
+	requestedNumBands.store(numBands, std::memory_order_relaxed);
+	requestedVersion.fetch_add(1, std::memory_order_release);
+}
+
+template<typename SampleType>
+void LinearPhaseCrossover::process(const juce::dsp::AudioBlock<const SampleType>& input, const BandBlocks<SampleType>& bands, int numBands) noexcept
+{
+	const auto numChannels = input.getNumChannels();
+	const auto numSamples = input.getNumSamples();
+
+	jassert(numChannels <= state.size());
+	jassert(numBands <= Params::MaxBands);
+
+	size_t done = 0;
+	while (done < numSamples)
+	{
+		auto numToCopy = juce::jmin(numSamples - done, static_cast<size_t>(partitionSize - fifoPosition));
+
+		for (size_t ch = 0; ch < numChannels; ++ch)
+		{
+			auto& s = state[ch];
+
+			//the FIR runs in float, so the double build converts here rather than narrowing inside the standard library
+			auto* channelInput = input.getChannelPointer(ch) + done;
+			std::transform(channelInput, channelInput + numToCopy, s.time.data() + partitionSize + fifoPosition,
+				[](SampleType sample) { return static_cast<float>(sample); });
+
+			for (int band = 0; band < numBands; ++band)
+			{
+				auto* bandOutput = s.output.data() + band * partitionSize + fifoPosition;
+				std::transform(bandOutput, bandOutput + numToCopy, bands[static_cast<size_t>(band)].getChannelPointer(ch) + done,
+					[](float sample) { return static_cast<SampleType>(sample); });
+			}
+		}
+
+		fifoPosition += static_cast<int>(numToCopy);
+		done += numToCopy;
+
+		if (fifoPosition == partitionSize)
+		{
+			fifoPosition = 0;
+			processPartition();
+		}
+	}
+}
+
+template void LinearPhaseCrossover::process<float>(const juce::dsp::AudioBlock<const float>&, const BandBlocks<float>&, int) noexcept;
+template void LinearPhaseCrossover::process<double>(const juce::dsp::AudioBlock<const double>&, const BandBlocks<double>&, int) noexcept;
+
+void LinearPhaseCrossover::processPartition() noexcept
+{
+	//only take a new set once the designer has collected the last one we handed back
+	Kernels* previousKernels = nullptr;
+	if (retiredKernels.load(std::memory_order_acquire) == nullptr)
+	{
+		if (auto* newKernels = pendingKernels.exchange(nullptr, std::memory_order_acq_rel))
+		{
+			previousKernels = activeKernels.release();
+			activeKernels.reset(newKernels);
+		}
+	}
+
+	const auto spectrumSize = numBins * 2;
+
+	for (auto& s : state)
+	{
+		//the newest input spectrum goes into the frequency-domain delay line
+		std::copy(s.time.begin(), s.time.end(), fftBuffer.begin());
+		std::fill(fftBuffer.begin() + fftSize, fftBuffer.end(), 0.f);
+		fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+		std::copy_n(fftBuffer.data(), spectrumSize, s.delayLine.data() + delayLinePosition * spectrumSize);
+
+		std::copy_n(s.time.data() + partitionSize, partitionSize, s.time.data());
+
+		for (int band = 0; band < Params::MaxBands; ++band)
+		{
+			auto* output = s.output.data() + band * partitionSize;
+			convolve(*activeKernels, band, s.delayLine.data(), output);
+
+			if (previousKernels != nullptr)
+			{
+				convolve(*previousKernels, band, s.delayLine.data(), fadeBuffer.data());
+
+				for (int i = 0; i < partitionSize; ++i)
+				{
+					auto fade = static_cast<float>(i + 1) / partitionSize;
+					output[i] = fadeBuffer[static_cast<size_t>(i)] + (output[i] - fadeBuffer[static_cast<size_t>(i)]) * fade;
+				}
+			}
+		}
+	}
+
+	delayLinePosition = (delayLinePosition + 1) % numPartitions;
+
+	if (previousKernels != nullptr)
+	{
+		retiredKernels.store(previousKernels, std::memory_order_release);
+	}
+}
+
+void LinearPhaseCrossover::convolve(const Kernels& kernels, int band, const float* delayLine, float* output) noexcept
+{
+	if (band >= kernels.numBands)
+	{
+		std::fill_n(output, partitionSize, 0.f);
+		return;
+	}
+
+	const auto spectrumSize = numBins * 2;
+	std::fill(accumulator.begin(), accumulator.end(), 0.f);
+
+	//partition p of the kernel meets the input spectrum from p partitions ago
+	auto slot = delayLinePosition;
+	for (int p = 0; p < numPartitions; ++p)
+	{
+		const auto* x = delayLine + slot * spectrumSize;
+		const auto* h = kernels.spectra.data() + (band * numPartitions + p) * spectrumSize;
+		auto* acc = accumulator.data();
+
+		for (int k = 0; k < spectrumSize; k += 2)
+		{
+			acc[k] += x[k] * h[k] - x[k + 1] * h[k + 1];
+			acc[k + 1] += x[k] * h[k + 1] + x[k + 1] * h[k];
+		}
+
+		slot = slot == 0 ? numPartitions - 1 : slot - 1;
+	}
+
+	std::copy(accumulator.begin(), accumulator.end(), fftBuffer.begin());
+	fft.performRealOnlyInverseTransform(fftBuffer.data());
+
+	//overlap-save: the first half is circular wrap-around, the second half is the new output
+	std::copy_n(fftBuffer.data() + partitionSize, partitionSize, output);
+}
+
+void LinearPhaseCrossover::run()
+{
+	while (!threadShouldExit())
+	{
+		freeRetiredKernels();
+
+		auto version = requestedVersion.load(std::memory_order_acquire);
+		if (version != designedVersion)
+		{
+			designedVersion = version;
+			publish(designKernels(designerFFT));
+		}
+
+		wait(-1);
+	}
+}
+
+std::unique_ptr<LinearPhaseCrossover::Kernels> LinearPhaseCrossover::designKernels(juce::dsp::FFT& fftToUse) const
+{
+	const auto numBands = juce::jlimit(Params::MinBands, Params::MaxBands, requestedNumBands.load(std::memory_order_relaxed));
+	const auto taps = static_cast<size_t>(numTaps);
+	const auto centre = (numTaps - 1) / 2;
+	const auto spectrumSize = static_cast<size_t>(numBins * 2);
+
+	auto kernels = std::make_unique<Kernels>();
+	kernels->numBands = numBands;
+	kernels->spectra.assign(static_cast<size_t>(numBands * numPartitions) * spectrumSize, 0.f);
+
+	std::vector<double> window(taps);
+	juce::dsp::WindowingFunction<double>::fillWindowingTables(window.data(), taps, juce::dsp::WindowingFunction<double>::blackman, false);
+
+	//windowed sinc with unity gain at DC
+	auto makeLowpass = [&](float frequency, std::vector<double>& lowpass)
+	{
+		auto cutoff = juce::jlimit(1.0, sampleRate * 0.49, static_cast<double>(frequency)) / sampleRate;
+		auto sum = 0.0;
+
+		for (int n = 0; n < numTaps; ++n)
+		{
+			auto x = static_cast<double>(n - centre);
+			auto sinc = n == centre ? 2.0 * cutoff : std::sin(juce::MathConstants<double>::twoPi * cutoff * x) / (juce::MathConstants<double>::pi * x);
+			lowpass[static_cast<size_t>(n)] = sinc * window[static_cast<size_t>(n)];
+			sum += lowpass[static_cast<size_t>(n)];
+		}
+
+		for (auto& h : lowpass)
+		{
+			h /= sum;
+		}
+	};
+
+	std::vector<double> previousLowpass(taps, 0.0), lowpass(taps, 0.0);
+	std::vector<float> buffer(fftSize * 2);
+
+	for (int band = 0; band < numBands; ++band)
+	{
+		//the top band is everything the lowpasses below it left over
+		if (band < numBands - 1)
+		{
+			makeLowpass(requestedFrequencies[static_cast<size_t>(band)].load(std::memory_order_relaxed), lowpass);
+		}
+		else
+		{
+			std::fill(lowpass.begin(), lowpass.end(), 0.0);
+			lowpass[static_cast<size_t>(centre)] = 1.0;
+		}
+
+		for (int p = 0; p < numPartitions; ++p)
+		{
+			std::fill(buffer.begin(), buffer.end(), 0.f);
+
+			for (int i = 0; i < partitionSize; ++i)
+			{
+				auto n = static_cast<size_t>(p * partitionSize + i);
+				if (n < taps)
+				{
+					buffer[static_cast<size_t>(i)] = static_cast<float>(lowpass[n] - previousLowpass[n]);
+				}
+			}
+
+			fftToUse.performRealOnlyForwardTransform(buffer.data(), true);
+
+			auto offset = static_cast<size_t>(band * numPartitions + p) * spectrumSize;
+			std::copy_n(buffer.data(), spectrumSize, kernels->spectra.data() + offset);
+		}
+
+		std::swap(previousLowpass, lowpass);
+	}
+
+	return kernels;
+}
+
+void LinearPhaseCrossover::publish(std::unique_ptr<Kernels> kernels) noexcept
+{
+	freeRetiredKernels();
+
+	//a set the audio thread never picked up is simply replaced
+	delete pendingKernels.exchange(kernels.release(), std::memory_order_acq_rel);
+}
+
+void LinearPhaseCrossover::freeRetiredKernels() noexcept
+{
+	delete retiredKernels.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void LinearPhaseCrossover::clearKernels() noexcept
+{
+	delete pendingKernels.exchange(nullptr, std::memory_order_acq_rel);
+	freeRetiredKernels();
+	activeKernels.reset();
+}
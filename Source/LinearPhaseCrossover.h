@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.h
+    Created: 17 Oct 2026 1:18:52pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+
+/*
+	Linear-phase alternative to MultiBandCrossover.
+
+	Every band is a windowed-sinc FIR: band k is the lowpass at crossover k minus the lowpass at crossover k - 1,
+	so the bands always sum back to a pure delay. The kernels are applied with uniformly partitioned overlap-save
+	convolution: the input goes through a fixed-size partition FIFO, one forward FFT per partition is shared by all
+	bands, and each band costs one spectral multiply-accumulate over the delay line plus one inverse FFT.
+	The work per channel therefore only depends on the kernel length, never on the host block size.
+
+	Kernels are designed on a background thread whenever the crossovers change and handed to the audio thread
+	through an atomic pointer. The audio thread never allocates, frees or locks: it takes the pending set,
+	crossfades from the old set over one partition and hands the old set back for the designer thread to free.
+	The designer sleeps until the message thread wakes it through updateDesigner(), and only runs at all while
+	linear phase is in use.
+*/
+struct LinearPhaseCrossover : private juce::Thread
+{
+	static constexpr int partitionSize = 256;
+
+	template<typename SampleType>
+	using BandBlocks = std::array<juce::dsp::AudioBlock<SampleType>, Params::MaxBands>;
+	using Frequencies = std::array<float, Params::MaxBands - 1>;
+
+	LinearPhaseCrossover();
+	~LinearPhaseCrossover() override;
+
+	//designs the first kernel set synchronously, so call it off the audio thread
+	void prepare(const juce::dsp::ProcessSpec& spec);
+	void reset() noexcept;
+
+	//audio thread: only flags a new design when something actually changed
+	void setCrossoverFrequencies(const Frequencies& frequencies, int numBands) noexcept;
+
+	//audio thread: whether process() is being called, the designer is stopped while it isn't
+	void setInUse(bool shouldBeInUse) noexcept { inUse.store(shouldBeInUse, std::memory_order_release); }
+
+	//message thread: starts or stops the designer to follow setInUse() and wakes it for any new request
+	void updateDesigner();
+
+	//partition FIFO plus half the kernel
+	int getLatencyInSamples() const noexcept { return partitionSize + (numTaps - 1) / 2; }
+
+	//the convolution itself always runs in float, double blocks are converted on the copies into and out of the FIFO
+	template<typename SampleType>
+	void process(const juce::dsp::AudioBlock<const SampleType>& input, const BandBlocks<SampleType>& bands, int numBands) noexcept;
+private:
+	static constexpr int fftOrder = 9;
+	static constexpr int fftSize = 1 << fftOrder;
+	static constexpr int numBins = fftSize / 2 + 1;
+	static_assert(fftSize == 2 * partitionSize, "overlap-save needs an FFT twice the partition size");
+
+	//roughly 90ms of kernel, enough to resolve the lowest crossovers
+	static constexpr double kernelLengthSeconds = 0.09;
+
+	//the spectra of every band's kernel partitions, band-major then partition-major, interleaved complex
+	struct Kernels
+	{
+		int numBands{ 0 };
+		std::vector<float> spectra;
+	};
+
+	struct ChannelState
+	{
+		std::vector<float> time;                  //previous partition followed by the one being filled
+		std::vector<float> delayLine;             //input spectra of the last numPartitions partitions
+		std::vector<float> output;                //one partition of output per band
+	};
+
+	double sampleRate{ 44100.0 };
+	int numTaps{ partitionSize - 1 };
+	int numPartitions{ 1 };
+
+	juce::dsp::FFT fft{ fftOrder };
+	juce::dsp::FFT designerFFT{ fftOrder };
+
+	std::vector<ChannelState> state;
+	std::vector<float> fftBuffer, accumulator, fadeBuffer;
+	int fifoPosition{ 0 };
+	int delayLinePosition{ 0 };
+
+	std::unique_ptr<Kernels> activeKernels;
+	std::atomic<Kernels*> pendingKernels{ nullptr };
+	std::atomic<Kernels*> retiredKernels{ nullptr };
+
+	//requests from the audio thread, the version is bumped after the values are written
+	std::array<std::atomic<float>, Params::MaxBands - 1> requestedFrequencies;
+	std::atomic<int> requestedNumBands{ Params::DefaultBands };
+	std::atomic<uint32_t> requestedVersion{ 0 };
+	uint32_t designedVersion{ 0 };
+
+	//keeps prepare() and updateDesigner() from starting and stopping the designer at the same time
+	std::atomic<bool> inUse{ false };
+	juce::CriticalSection designerLock;
+	uint32_t notifiedVersion{ 0 };
+
+	Frequencies lastFrequencies{};
+	int lastNumBands{ 0 };
+
+	void run() override;
+
+	std::unique_ptr<Kernels> designKernels(juce::dsp::FFT& fftToUse) const;
+	void publish(std::unique_ptr<Kernels> kernels) noexcept;
+	void freeRetiredKernels() noexcept;
+	void clearKernels() noexcept;
+
+	void processPartition() noexcept;
+	void convolve(const Kernels& kernels, int band, const float* delayLine, float* output) noexcept;
+};
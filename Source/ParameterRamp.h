@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    ParameterRamp.h
+    Created: 17 Oct 2026 3:26:40pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//where a ramp starts and ends over one block, the DSP interpolates in between
+template<typename T>
+struct RampSegment
+{
+	T start, end;
+
+	bool isStatic() const noexcept { return start == end; }
+
+	//per-sample step that lands exactly on end at the last of numSamples samples
+	T getIncrement(size_t numSamples) const noexcept
+	{
+		return numSamples > 0 ? (end - start) / static_cast<T>(numSamples) : T(0);
+	}
+};
+
+/*
+	Block-wise view of a juce::SmoothedValue: instead of ticking once per sample, advance() moves the ramp
+	by a whole block and returns the segment it covered. Once the target is reached every segment is static,
+	so callers pick their constant path with one check per block instead of a branch per sample.
+*/
+template<typename T, typename SmoothingType = juce::ValueSmoothingTypes::Linear>
+struct ParameterRamp
+{
+	void prepare(double sampleRate, double rampLengthInSeconds) noexcept
+	{
+		value.reset(sampleRate, rampLengthInSeconds);
+	}
+
+	void setTarget(T newTarget) noexcept { value.setTargetValue(newTarget); }
+
+	//jump straight to the target, for resets and the very first value
+	void snapToTarget() noexcept { value.setCurrentAndTargetValue(value.getTargetValue()); }
+	void snapTo(T newValue) noexcept { value.setCurrentAndTargetValue(newValue); }
+
+	T getCurrent() const noexcept { return value.getCurrentValue(); }
+	T getTarget() const noexcept { return value.getTargetValue(); }
+	bool isSmoothing() const noexcept { return value.isSmoothing(); }
+
+	RampSegment<T> advance(int numSamples) noexcept
+	{
+		auto start = value.getCurrentValue();
+		if (!value.isSmoothing())
+		{
+			return { start, start };
+		}
+
+		return { start, value.skip(numSamples) };
+	}
+private:
+	juce::SmoothedValue<T, SmoothingType> value;
+};
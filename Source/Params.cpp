@@ -9,3 +9,95 @@
 */
 
 #include "Params.h"
+
+namespace Params
+{
+	Registry::Registry(juce::AudioProcessorValueTreeState& apvtsToUse) :
+		apvts(apvtsToUse)
+	{
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			values[i] = apvts.getRawParameterValue(ParamIDs[i]);
+			jassert(values[i] != nullptr);
+
+			//the tree's listeners are called once the raw value is stored, so a reader that sees the new epoch sees the new value
+			apvts.addParameterListener(ParamIDs[i], this);
+		}
+	}
+
+	Registry::~Registry()
+	{
+		for (const auto* id : ParamIDs)
+		{
+			apvts.removeParameterListener(id, this);
+		}
+	}
+
+	void Registry::parameterChanged(const juce::String&, float)
+	{
+		//can arrive on any thread, including the audio thread during automation
+		epoch.fetch_add(1, std::memory_order_release);
+	}
+
+	int Registry::getNumBands() const noexcept
+	{
+		return juce::jlimit(MinBands, MaxBands, juce::roundToInt(get(Band_Count)));
+	}
+
+	BandSettings Registry::getBand(int band) const noexcept
+	{
+		const auto& names = BandParams[static_cast<size_t>(band)];
+
+		BandSettings settings;
+		settings.inputGainInDecibels = get(names.inputGain);
+		settings.drive = get(names.distortion);
+		settings.outputGainInDecibels = get(names.outputGain);
+		settings.bypassed = get(names.bypassed) > 0.5f;
+		settings.oversampling = juce::roundToInt(get(names.oversampling));
+		settings.shape = juce::roundToInt(get(names.shape));
+		settings.stereoMode = juce::roundToInt(get(names.stereoMode));
+		settings.sideDrive = get(names.sideDistortion);
+		return settings;
+	}
+
+	Snapshot Registry::capture() const noexcept
+	{
+		Snapshot snapshot;
+		snapshot.numBands = getNumBands();
+		for (size_t i = 0; i < CrossoverParams.size(); ++i)
+		{
+			snapshot.crossoverFreqs[i] = get(CrossoverParams[i]);
+		}
+		for (int band = 0; band < snapshot.numBands; ++band)
+		{
+			snapshot.bands[static_cast<size_t>(band)] = getBand(band);
+		}
+		snapshot.linearPhase = juce::roundToInt(get(Crossover_Mode)) == 1;
+		snapshot.channelLink = get(Channel_Link) > 0.5f;
+		snapshot.shaperMode = juce::roundToInt(get(Shaper_Mode));
+		snapshot.parallelBands = get(Parallel_Bands) > 0.5f;
+		snapshot.amortizedBlocks = juce::roundToInt(get(Block_Mode)) == 1;
+		return snapshot;
+	}
+
+	std::array<float, MaxBands - 1> GetCrossoverFrequencies(const Snapshot& snapshot, double sampleRate) noexcept
+	{
+		constexpr auto minRatio = 1.1f;
+
+		//before the processor is prepared there is no top of the range, the knobs' own range still keeps them apart
+		const auto maxFreq = sampleRate > 0.0 ? static_cast<float>(sampleRate * 0.45) : std::numeric_limits<float>::max();
+		const auto numSplits = snapshot.numBands - 1;
+
+		std::array<float, MaxBands - 1> freqs{};
+		auto previousFreq = 0.f;
+		for (int i = 0; i < numSplits; ++i)
+		{
+			const auto headroom = std::pow(minRatio, static_cast<float>(numSplits - 1 - i));
+			auto freq = juce::jmax(snapshot.crossoverFreqs[static_cast<size_t>(i)], previousFreq * minRatio);
+			freqs[static_cast<size_t>(i)] = juce::jmin(maxFreq / headroom, freq);
+			previousFreq = freqs[static_cast<size_t>(i)];
+		}
+
+		return freqs;
+	}
+}
@@ -10,7 +10,6 @@
 
 #pragma once
 #include <JuceHeader.h>
-using WaveShaper = juce::dsp::WaveShaper<float, std::function<float(float)>>;
 namespace Params
 {
 	enum Names
@@ -33,32 +32,352 @@ namespace Params
 		Bypassed_Low_Band,
 		Bypassed_Mid_Band,
 		Bypassed_High_Band,
+
+		Oversampling_Low_Band,
+		Oversampling_Mid_Band,
+		Oversampling_High_Band,
+
+		Shape_Low_Band,
+		Shape_Mid_Band,
+		Shape_High_Band,
+
+		Band_Count,
+
+		Crossover_3_Freq,
+		Crossover_4_Freq,
+		Crossover_5_Freq,
+		Crossover_6_Freq,
+		Crossover_7_Freq,
+
+		InputGain_Band_4,
+		Distortion_Band_4,
+		OutputGain_Band_4,
+		Bypassed_Band_4,
+		Oversampling_Band_4,
+		Shape_Band_4,
+
+		InputGain_Band_5,
+		Distortion_Band_5,
+		OutputGain_Band_5,
+		Bypassed_Band_5,
+		Oversampling_Band_5,
+		Shape_Band_5,
+
+		InputGain_Band_6,
+		Distortion_Band_6,
+		OutputGain_Band_6,
+		Bypassed_Band_6,
+		Oversampling_Band_6,
+		Shape_Band_6,
+
+		InputGain_Band_7,
+		Distortion_Band_7,
+		OutputGain_Band_7,
+		Bypassed_Band_7,
+		Oversampling_Band_7,
+		Shape_Band_7,
+
+		InputGain_Band_8,
+		Distortion_Band_8,
+		OutputGain_Band_8,
+		Bypassed_Band_8,
+		Oversampling_Band_8,
+		Shape_Band_8,
+
+		Crossover_Mode,
+		Channel_Link,
+		Shaper_Mode,
+		Parallel_Bands,
+		Block_Mode,
+
+		StereoMode_Low_Band,
+		SideDistortion_Low_Band,
+
+		StereoMode_Mid_Band,
+		SideDistortion_Mid_Band,
+
+		StereoMode_High_Band,
+		SideDistortion_High_Band,
+
+		StereoMode_Band_4,
+		SideDistortion_Band_4,
+
+		StereoMode_Band_5,
+		SideDistortion_Band_5,
+
+		StereoMode_Band_6,
+		SideDistortion_Band_6,
+
+		StereoMode_Band_7,
+		SideDistortion_Band_7,
+
+		StereoMode_Band_8,
+		SideDistortion_Band_8,
+
+		NumParams
+	};
+
+	//parameter IDs in Names order, so an ID is an array index away rather than a map lookup
+	inline constexpr std::array<const char*, NumParams> ParamIDs
+	{
+		"Low-Mid Frequency",
+		"Mid-High Frequency",
+
+		"Low Input Gain",
+		"Low Distortion",
+		"Low OutputGain",
+
+		"Mid Input Gain",
+		"Mid Distortion",
+		"Mid OutputGain",
+
+		"High Input Gain",
+		"High Distortion",
+		"High OutputGain",
+
+		"Low Bypass",
+		"Mid Bypass",
+		"High Bypass",
+
+		"Low Oversampling",
+		"Mid Oversampling",
+		"High Oversampling",
+
+		"Low Shape",
+		"Mid Shape",
+		"High Shape",
+
+		"Band Count",
+
+		"Crossover 3 Frequency",
+		"Crossover 4 Frequency",
+		"Crossover 5 Frequency",
+		"Crossover 6 Frequency",
+		"Crossover 7 Frequency",
+
+		"Band 4 Input Gain",
+		"Band 4 Distortion",
+		"Band 4 OutputGain",
+		"Band 4 Bypass",
+		"Band 4 Oversampling",
+		"Band 4 Shape",
+
+		"Band 5 Input Gain",
+		"Band 5 Distortion",
+		"Band 5 OutputGain",
+		"Band 5 Bypass",
+		"Band 5 Oversampling",
+		"Band 5 Shape",
+
+		"Band 6 Input Gain",
+		"Band 6 Distortion",
+		"Band 6 OutputGain",
+		"Band 6 Bypass",
+		"Band 6 Oversampling",
+		"Band 6 Shape",
+
+		"Band 7 Input Gain",
+		"Band 7 Distortion",
+		"Band 7 OutputGain",
+		"Band 7 Bypass",
+		"Band 7 Oversampling",
+		"Band 7 Shape",
+
+		"Band 8 Input Gain",
+		"Band 8 Distortion",
+		"Band 8 OutputGain",
+		"Band 8 Bypass",
+		"Band 8 Oversampling",
+		"Band 8 Shape",
+
+		"Crossover Mode",
+		"Channel Link",
+		"Shaper Mode",
+		"Parallel Bands",
+		"Block Mode",
+
+		"Low Stereo Mode",
+		"Low Side Distortion",
+
+		"Mid Stereo Mode",
+		"Mid Side Distortion",
+
+		"High Stereo Mode",
+		"High Side Distortion",
+
+		"Band 4 Stereo Mode",
+		"Band 4 Side Distortion",
+
+		"Band 5 Stereo Mode",
+		"Band 5 Side Distortion",
+
+		"Band 6 Stereo Mode",
+		"Band 6 Side Distortion",
+
+		"Band 7 Stereo Mode",
+		"Band 7 Side Distortion",
+
+		"Band 8 Stereo Mode",
+		"Band 8 Side Distortion",
+	};
+
+	inline constexpr int MinBands = 2;
+	inline constexpr int MaxBands = 8;
+	inline constexpr int DefaultBands = 3;
+
+	struct BandParamNames
+	{
+		Names inputGain, distortion, outputGain, bypassed, oversampling, shape, stereoMode, sideDistortion;
+	};
+
+	inline constexpr std::array<BandParamNames, MaxBands> BandParams
+	{ {
+		{ InputGain_Low_Band, Distortion_Low_Band, OutputGain_Low_Band, Bypassed_Low_Band, Oversampling_Low_Band, Shape_Low_Band, StereoMode_Low_Band, SideDistortion_Low_Band },
+		{ InputGain_Mid_Band, Distortion_Mid_Band, OutputGain_Mid_Band, Bypassed_Mid_Band, Oversampling_Mid_Band, Shape_Mid_Band, StereoMode_Mid_Band, SideDistortion_Mid_Band },
+		{ InputGain_High_Band, Distortion_High_Band, OutputGain_High_Band, Bypassed_High_Band, Oversampling_High_Band, Shape_High_Band, StereoMode_High_Band, SideDistortion_High_Band },
+		{ InputGain_Band_4, Distortion_Band_4, OutputGain_Band_4, Bypassed_Band_4, Oversampling_Band_4, Shape_Band_4, StereoMode_Band_4, SideDistortion_Band_4 },
+		{ InputGain_Band_5, Distortion_Band_5, OutputGain_Band_5, Bypassed_Band_5, Oversampling_Band_5, Shape_Band_5, StereoMode_Band_5, SideDistortion_Band_5 },
+		{ InputGain_Band_6, Distortion_Band_6, OutputGain_Band_6, Bypassed_Band_6, Oversampling_Band_6, Shape_Band_6, StereoMode_Band_6, SideDistortion_Band_6 },
+		{ InputGain_Band_7, Distortion_Band_7, OutputGain_Band_7, Bypassed_Band_7, Oversampling_Band_7, Shape_Band_7, StereoMode_Band_7, SideDistortion_Band_7 },
+		{ InputGain_Band_8, Distortion_Band_8, OutputGain_Band_8, Bypassed_Band_8, Oversampling_Band_8, Shape_Band_8, StereoMode_Band_8, SideDistortion_Band_8 },
+	} };
+
+	//crossover k sits between band k and band k + 1
+	inline constexpr std::array<Names, MaxBands - 1> CrossoverParams
+	{
+		Low_Mid_Crossover_Freq,
+		Mid_High_Crossover_Freq,
+		Crossover_3_Freq,
+		Crossover_4_Freq,
+		Crossover_5_Freq,
+		Crossover_6_Freq,
+		Crossover_7_Freq,
 	};
 
 	inline const std::map<Names, juce::String>& GetParams()
 	{
-		static std::map<Names, juce::String> params =
+		static std::map<Names, juce::String> params = []()
 		{
-			{Low_Mid_Crossover_Freq, "Low-Mid Frequency"},
-			{Mid_High_Crossover_Freq, "Mid-High Frequency"},
+			std::map<Names, juce::String> map;
+			for (int i = 0; i < NumParams; ++i)
+			{
+				map.emplace(static_cast<Names>(i), ParamIDs[static_cast<size_t>(i)]);
+			}
+			return map;
+		}();
+		return params;
+	}
 
-			{InputGain_Low_Band, "Low Input Gain"},
-			{Distortion_Low_Band, "Low Distortion"},
-			{OutputGain_Low_Band, "Low OutputGain"},
+	//plain values of one band, read in one go at the top of a block
+	struct BandSettings
+	{
+		float inputGainInDecibels{ 0.f };
+		float drive{ 0.f };
+		float outputGainInDecibels{ 0.f };
+		bool bypassed{ false };
+		int oversampling{ 0 };
+		int shape{ 0 };
+		int stereoMode{ 0 };
+		float sideDrive{ 0.f };
+	};
 
-			{InputGain_Mid_Band, "Mid Input Gain"},
-			{Distortion_Mid_Band, "Mid Distortion"},
-			{OutputGain_Mid_Band, "Mid OutputGain"},
+	struct Snapshot
+	{
+		int numBands{ DefaultBands };
+		std::array<float, MaxBands - 1> crossoverFreqs{};
+		std::array<BandSettings, MaxBands> bands;
+		bool linearPhase{ false };
+		bool channelLink{ false };
+		int shaperMode{ 0 };
+		bool parallelBands{ false };
+		bool amortizedBlocks{ false };
+	};
+
+	//resolves every parameter's std::atomic<float>* once, the audio thread then only does relaxed loads
+	struct Registry : private juce::AudioProcessorValueTreeState::Listener
+	{
+		explicit Registry(juce::AudioProcessorValueTreeState& apvts);
+		~Registry() override;
 
+		//bumped after any parameter changes, so a reader that saw the old epoch re-reads on its next check
+		uint32_t getEpoch() const noexcept { return epoch.load(std::memory_order_acquire); }
 
-			{InputGain_High_Band, "High Input Gain"},
-			{Distortion_High_Band, "High Distortion"},
-			{OutputGain_High_Band, "High OutputGain"},
+		float get(Names name) const noexcept
+		{
+			return values[static_cast<size_t>(name)]->load(std::memory_order_relaxed);
+		}
 
-			{Bypassed_Low_Band, "Low Bypass"},
-			{Bypassed_Mid_Band, "Mid Bypass"},
-			{Bypassed_High_Band, "High Bypass"},
-		};
-		return params;
+		int getNumBands() const noexcept;
+		BandSettings getBand(int band) const noexcept;
+		Snapshot capture() const noexcept;
+	private:
+		juce::AudioProcessorValueTreeState& apvts;
+		std::array<std::atomic<float>*, NumParams> values;
+		std::atomic<uint32_t> epoch{ 0 };
+
+		void parameterChanged(const juce::String& parameterID, float newValue) override;
+	};
+
+	//the crossovers the DSP actually runs: each at least 10% above the one below it whatever order the knobs are in,
+	//and each low enough that the ones above it still fit under 0.45 * sampleRate
+	std::array<float, MaxBands - 1> GetCrossoverFrequencies(const Snapshot& snapshot, double sampleRate) noexcept;
+
+	inline const juce::StringArray& GetOversamplingChoices()
+	{
+		static juce::StringArray choices { "Off", "2x", "4x", "8x" };
+		return choices;
+	}
+
+	//button/label text for band index when numBands bands are active
+	inline juce::String GetBandName(int band, int numBands)
+	{
+		if (band == 0)
+			return "Low";
+		if (band == numBands - 1)
+			return "High";
+		if (numBands == 3)
+			return "Mid";
+
+		return "Mid " + juce::String(band);
+	}
+
+	inline const juce::StringArray& GetCrossoverModeChoices()
+	{
+		static juce::StringArray choices { "Minimum Phase", "Linear Phase" };
+		return choices;
+	}
+
+	inline const juce::StringArray& GetShaperModeChoices()
+	{
+		static juce::StringArray choices { "Direct", "Lookup Table", "ADAA 1st Order", "ADAA 2nd Order" };
+		return choices;
+	}
+
+	//amortized re-blocks into a fixed quantum for lower per-block overhead, at a quantum of extra latency
+	inline const juce::StringArray& GetBlockModeChoices()
+	{
+		static juce::StringArray choices { "Zero Latency", "Amortized" };
+		return choices;
+	}
+
+	//the stereo mode choices in order, mid and side only shape that part of the signal, M/S shapes both with their own drive
+	enum class StereoMode
+	{
+		stereo,
+		mid,
+		side,
+		midSide,
+	};
+
+	inline const juce::StringArray& GetStereoModeChoices()
+	{
+		static juce::StringArray choices { "Stereo", "Mid", "Side", "M/S" };
+		return choices;
+	}
+
+	inline const juce::StringArray& GetShapeChoices()
+	{
+		static juce::StringArray choices { "Hard Clip", "Soft Clip", "Tanh", "Foldback" };
+		return choices;
 	}
 }
\ No newline at end of file
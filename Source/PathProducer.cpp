@@ -12,42 +12,50 @@
 
 void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
+    //only the newest window matters, so whatever arrived since the last call costs one read however the host blocked it
+    const auto windowSize = monoBuffer.getNumSamples();
+    const auto available = leftChannelFifo->getNumSamplesAvailable();
+    if (available > windowSize)
     {
-        if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
-        {
-            auto size = tempIncomingBuffer.getNumSamples();
+        leftChannelFifo->discard(available - windowSize);
+    }
 
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
+    const auto size = juce::jmin(available, windowSize);
+    if (size > 0)
+    {
+        auto writePointer = monoBuffer.getWritePointer(0, 0);
+        auto readPointer = monoBuffer.getReadPointer(0, size);
 
-            std::copy(readPointer, readPointer + (monoBuffer.getNumSamples() - size), writePointer);
+        std::copy(readPointer, readPointer + (windowSize - size), writePointer);
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                tempIncomingBuffer.getReadPointer(0, 0),
-                size);
+        leftChannelFifo->read(monoBuffer.getWritePointer(0, windowSize - size), size);
+    }
 
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
-        }
+    //a frame is due once a hop's worth of new audio has come in, any more than that is caught up in the same frame
+    samplesSinceLastFrame += available;
+    if (samplesSinceLastFrame >= hopSize.load(std::memory_order_relaxed))
+    {
+        samplesSinceLastFrame = 0;
+        leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
     }
 
     const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
     const auto binWidth = sampleRate / double(fftSize);
 
-    while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+    while (auto* fftData = leftChannelFFTDataGenerator.acquireFFTData())
     {
-        std::vector<float> fftData;
-        if (leftChannelFFTDataGenerator.getFFTData(fftData))
-        {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
-        }
+        pathProducer.generatePath(*fftData, fftBounds, fftSize, binWidth, negativeInfinity);
+        leftChannelFFTDataGenerator.releaseFFTData();
     }
+}
 
+bool PathProducer::pullPath()
+{
+    auto pulled = false;
     while (pathProducer.getNumPathsAvailable() > 0)
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        pulled = pathProducer.swapPath(leftChannelFFTPath) || pulled;
     }
+
+    return pulled;
 }
@@ -15,21 +15,35 @@
 #include "PluginProcessor.h"
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<MBDistortionAudioProcessor::BlockType>& scsf) :
+    PathProducer(SingleChannelSampleFifo& scsf) :
         leftChannelFifo(&scsf)
     {
         leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
         monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
+        hopSize = leftChannelFFTDataGenerator.getFFTSize() / defaultOverlap;
     }
+    //analysis thread: turns whatever audio has arrived into at most one new path
     void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+
+    //message thread: swaps in the newest finished path, true if there was one
+    bool pullPath();
+    const juce::Path& getPath() const { return leftChannelFFTPath; }
 
     void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
+
+    //new samples needed between frames, fftSize / hopSize is the overlap
+    void setHopSize(int newHopSize) { hopSize.store(juce::jlimit(1, monoBuffer.getNumSamples(), newHopSize)); }
+    int getHopSize() const { return hopSize.load(); }
 private:
-    SingleChannelSampleFifo<MBDistortionAudioProcessor::BlockType>* leftChannelFifo;
+    SingleChannelSampleFifo* leftChannelFifo;
 
     juce::AudioBuffer<float> monoBuffer;
 
+    //75% overlap suits the Blackman-Harris window, and at most one frame is rendered per call whatever the hop
+    static constexpr int defaultOverlap = 4;
+    std::atomic<int> hopSize{ 512 };
+    int samplesSinceLastFrame{ 0 };
+
     FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
 
     AnalyzerPathGenerator<juce::Path> pathProducer;
@@ -11,13 +11,6 @@
 #include "Params.h"
 #include "DistortionBand.h"
 //==============================================================================
-DistortionBand::DistortionBand(juce::AudioProcessorValueTreeState* apvts, BandFreq bandFrequency) :
-	bandFreq{ bandFrequency },
-	p_apvts{ apvts }
-{
-	updateDistortionSettings();
-}
-
 MBDistortionAudioProcessor::MBDistortionAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
 	: AudioProcessor(BusesProperties()
@@ -30,30 +23,14 @@ MBDistortionAudioProcessor::MBDistortionAudioProcessor()
 	)
 #endif
 {
-	p_lowBandDist = new DistortionBand(&apvts, DistortionBand::BandFreq::lowBand);
-	p_midBandDist = new DistortionBand(&apvts, DistortionBand::BandFreq::midBand);
-	p_highBandDist = new DistortionBand(&apvts, DistortionBand::BandFreq::highBand);
-
-	using namespace Params;
-	const auto& params = GetParams();
-
-	lowMidCrossover = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Low-Mid Frequency"));
-	jassert(lowMidCrossover != nullptr);
-	midHighCrossover = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Mid-High Frequency"));
-	jassert(lowMidCrossover != nullptr);
-
-	LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-	HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-
-	AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-
-	LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-	HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-
+	apvts.addParameterListener(Params::GetParams().at(Params::Parallel_Bands), this);
+	startTimerHz(messageThreadPollHz);
 }
 
 MBDistortionAudioProcessor::~MBDistortionAudioProcessor()
 {
+	stopTimer();
+	apvts.removeParameterListener(Params::GetParams().at(Params::Parallel_Bands), this);
 }
 
 
@@ -92,7 +69,8 @@ bool MBDistortionAudioProcessor::isMidiEffect() const
 
 double MBDistortionAudioProcessor::getTailLengthSeconds() const
 {
-	return 0.0;
+	//the lowest LR4 crossover and the back half of the linear-phase kernels both ring out well inside this
+	return ringOutSeconds;
 }
 
 int MBDistortionAudioProcessor::getNumPrograms()
@@ -127,18 +105,36 @@ void MBDistortionAudioProcessor::prepareToPlay(double sampleRate, int samplesPer
 	spec.numChannels = getTotalNumInputChannels();
 	spec.sampleRate = sampleRate;
 
-	LP1.prepare(spec);
-	HP1.prepare(spec);
+	//the host picks its precision before preparing, so the other chain never needs any memory
+	//amortized mode hands the DSP whole quanta, so everything has to take one even when the host's blocks are smaller
+	spec.maximumBlockSize = static_cast<juce::uint32>(juce::jmax(samplesPerBlock, processingQuantum));
+	forActiveChain([&](auto& chain) { chain.prepare(spec, processingQuantum); });
+
+	//hosts say whether they're bouncing before preparing, everything the profile can pick is allocated above either way
+	renderProfile = isNonRealtime();
+
+	//the first instance to get here builds the shared tables, so updateState can hand them out
+	ShaperTables::prepare();
 
-	AP2.prepare(spec);
+	stateEpoch = paramRegistry.getEpoch();
+	updateState(captureSettings());
 
-	LP2.prepare(spec);
-	HP2.prepare(spec);
+	//designs its first kernels from the crossovers updateState just handed it
+	linearPhaseCrossover.prepare(spec);
+	linearPhaseCrossover.updateDesigner();
+	updateLatency();
+	publishLatency();
+
+	//start on the current values instead of gliding in from the defaults
+	resetProcessingState();
+	silentSamples = 0;
+	idle = false;
 
-	for (auto& buffer : filterBuffers)
 	{
-		buffer.setSize(spec.numChannels, samplesPerBlock);
+		const juce::ScopedLock lock(bandWorkersLock);
+		bandWorkersPrepared = true;
 	}
+	updateBandWorkers();
 
 	leftChannelFifo.prepare(samplesPerBlock);	
 	rightChannelFifo.prepare(samplesPerBlock);
@@ -150,6 +146,42 @@ void MBDistortionAudioProcessor::releaseResources()
 {
 	// When playback stops, you can use this as an opportunity to free up any
 	// spare memory, etc.
+	const juce::ScopedLock lock(bandWorkersLock);
+	bandWorkersPrepared = false;
+	bandWorkers.release();
+}
+
+void MBDistortionAudioProcessor::updateBandWorkers()
+{
+	//the audio thread takes a share of the bands itself, so one worker fewer than the bands is enough
+	const juce::ScopedLock lock(bandWorkersLock);
+	const auto wanted = bandWorkersPrepared && paramRegistry.get(Params::Parallel_Bands) > 0.5f;
+	bandWorkers.prepare(wanted ? juce::jlimit(0, maxBandWorkers, juce::SystemStats::getNumCpus() - 1) : 0);
+}
+
+void MBDistortionAudioProcessor::timerCallback()
+{
+	updateBandWorkers();
+	linearPhaseCrossover.updateDesigner();
+	publishLatency();
+}
+
+void MBDistortionAudioProcessor::parameterChanged(const juce::String&, float)
+{
+	//only listening to the parallel bands switch; from any other thread the timer catches up with it
+	if (juce::MessageManager::existsAndIsCurrentThread())
+	{
+		updateBandWorkers();
+	}
+}
+
+void MBDistortionAudioProcessor::publishLatency()
+{
+	const auto latency = pendingLatency.load();
+	if (latency != getLatencySamples())
+	{
+		setLatencySamples(latency);
+	}
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -159,17 +191,14 @@ bool MBDistortionAudioProcessor::isBusesLayoutSupported(const BusesLayout& layou
 	juce::ignoreUnused(layouts);
 	return true;
 #else
-	// This is the place where you check if the layout is supported.
-	// In this template code we only support mono or stereo.
-	// Some plugin hosts, such as certain GarageBand versions, will only
-	// load plugins that support stereo bus layouts.
-	if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-		&& layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+	//any layout up to maxChannels works, surround and discrete alike, as long as it passes straight through
+	const auto& mainOutput = layouts.getMainOutputChannelSet();
+	if (mainOutput.isDisabled() || mainOutput.size() > maxChannels)
 		return false;
 
 	// This checks if the input layout matches the output layout
 #if ! JucePlugin_IsSynth
-	if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+	if (mainOutput != layouts.getMainInputChannelSet())
 		return false;
 #endif
 
@@ -177,51 +206,227 @@ bool MBDistortionAudioProcessor::isBusesLayoutSupported(const BusesLayout& layou
 #endif
 }
 #endif
-void MBDistortionAudioProcessor::updateState()
+template<typename Fn>
+void MBDistortionAudioProcessor::forActiveChain(Fn&& fn)
 {
-	auto lowMidCutoffFreq = lowMidCrossover->get();
-	LP1.setCutoffFrequency(lowMidCutoffFreq);
-	HP1.setCutoffFrequency(lowMidCutoffFreq);
+	if (isUsingDoublePrecision())
+		fn(doubleChain);
+	else
+		fn(floatChain);
+}
 
-	auto midHighCutoffFreq = midHighCrossover->get();
+Params::Snapshot MBDistortionAudioProcessor::captureSettings() const
+{
+	auto snapshot = paramRegistry.capture();
+	if (!renderProfile)
+	{
+		return snapshot;
+	}
+
+	//offline there's no deadline, so every band gets the most oversampling and the exact curves instead of tables
+	snapshot.linearPhase = true;
+	if (snapshot.shaperMode == static_cast<int>(Shapers::Mode::lookupTable))
+	{
+		snapshot.shaperMode = static_cast<int>(Shapers::Mode::direct);
+	}
 
-	AP2.setCutoffFrequency(midHighCutoffFreq);
-	LP2.setCutoffFrequency(midHighCutoffFreq);
-	HP2.setCutoffFrequency(midHighCutoffFreq);
+	for (auto& band : snapshot.bands)
+	{
+		band.oversampling = juce::jmax(band.oversampling, renderOversampling);
+	}
+
+	return snapshot;
 }
 
-void MBDistortionAudioProcessor::splitBands(const juce::AudioBuffer<float>& inputBuffer)
+void MBDistortionAudioProcessor::updateState(const Params::Snapshot& snapshot)
 {
-	for (auto& fb : filterBuffers)
+	shaperMode = static_cast<Shapers::Mode>(snapshot.shaperMode);
+	parallelBands = snapshot.parallelBands;
+
+	if (snapshot.amortizedBlocks != amortizedBlocks)
 	{
-		fb = inputBuffer;
+		amortizedBlocks = snapshot.amortizedBlocks;
+		forActiveChain([](auto& chain) { chain.quantumFifo.reset(); });
 	}
 
-	auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-	auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-	auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+	forActiveChain([&](auto& chain)
+	{
+		//checked against the chain itself, the one a precision switch just prepared has never been told the count
+		if (snapshot.numBands != chain.crossover.getNumBands())
+		{
+			numBands = snapshot.numBands;
+			chain.crossover.setNumBands(numBands);
+			for (auto& band : chain.bands)
+			{
+				band.reset();
+			}
+		}
 
-	auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-	auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-	auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+		if (snapshot.linearPhase != linearPhase)
+		{
+			//whichever crossover takes over still holds whatever it saw last time it ran
+			linearPhase = snapshot.linearPhase;
+			if (linearPhase)
+				linearPhaseCrossover.reset();
+			else
+				chain.crossover.reset();
+		}
+		linearPhaseCrossover.setInUse(linearPhase);
 
-	LP1.process(fb0Ctx);
-	AP2.process(fb0Ctx);
+		//the tree needs strictly rising crossovers, whatever order the knobs are in
+		const auto crossoverFreqs = Params::GetCrossoverFrequencies(snapshot, getSampleRate());
+		for (int i = 0; i < numBands - 1; ++i)
+		{
+			chain.crossover.setCrossoverFrequency(static_cast<size_t>(i), crossoverFreqs[static_cast<size_t>(i)]);
+		}
+		linearPhaseCrossover.setCrossoverFrequencies(crossoverFreqs, numBands);
 
-	HP1.process(fb1Ctx);
-	filterBuffers[2] = filterBuffers[1];
-	LP2.process(fb1Ctx);
-	HP2.process(fb2Ctx);
+		for (int i = 0; i < numBands; ++i)
+		{
+			auto& band = chain.bands[static_cast<size_t>(i)];
+			band.updateDistortionSettings(snapshot.bands[static_cast<size_t>(i)]);
+			band.setChannelLink(snapshot.channelLink);
+			band.setShaperMode(shaperMode);
 
-	p_lowBandDist->process(fb0Ctx);
-	p_midBandDist->process(fb1Ctx);
-	p_highBandDist->process(fb2Ctx);
+			const auto shape = static_cast<Shapers::Shape>(snapshot.bands[static_cast<size_t>(i)].shape);
+			band.setShaperTable(shaperMode == Shapers::Mode::lookupTable ? &ShaperTables::get(shape) : nullptr);
+		}
+	});
 }
 
-void MBDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void MBDistortionAudioProcessor::updateLatency()
+{
+	//a band with ADAA lags by a fraction of a sample, every band is aligned to the slowest rounded up to a whole one
+	auto latency = 0;
+	forActiveChain([&](auto& chain)
+	{
+		auto bandLatency = 0.0;
+		for (int i = 0; i < numBands; ++i)
+		{
+			bandLatency = juce::jmax(bandLatency, chain.bands[static_cast<size_t>(i)].updateOversampling());
+		}
+
+		latency = static_cast<int>(std::ceil(bandLatency));
+		for (int i = 0; i < numBands; ++i)
+		{
+			chain.bands[static_cast<size_t>(i)].setLatencyCompensation(static_cast<double>(latency));
+		}
+	});
+
+	//the FIR crossover delays every band by the same amount, so it only adds to what the host sees
+	if (linearPhase)
+	{
+		latency += linearPhaseCrossover.getLatencyInSamples();
+	}
+
+	if (amortizedBlocks)
+	{
+		latency += processingQuantum;
+	}
+
+	pendingLatency.store(latency);
+	idleHangoverSamples = latency + static_cast<int>(std::ceil(getSampleRate() * ringOutSeconds));
+}
+
+template<typename SampleType>
+bool MBDistortionAudioProcessor::updateIdleState(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	auto range = block.findMinAndMax();
+	auto peak = juce::jmax(-range.getStart(), range.getEnd());
+
+	if (peak > static_cast<SampleType>(silenceThreshold))
+	{
+		silentSamples = 0;
+		idle = false;
+		return false;
+	}
+
+	if (!idle)
+	{
+		silentSamples += static_cast<int>(block.getNumSamples());
+
+		//everything still in flight has come out by now, so zero the state rather than let it decay into denormals
+		if (silentSamples >= idleHangoverSamples)
+		{
+			resetProcessingState();
+			idle = true;
+		}
+	}
+
+	return idle;
+}
+
+void MBDistortionAudioProcessor::resetProcessingState()
+{
+	forActiveChain([](auto& chain) { chain.reset(); });
+	linearPhaseCrossover.reset();
+}
+
+template<typename SampleType>
+void MBDistortionAudioProcessor::splitBands(BandChain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block)
+{
+	const auto numSamples = block.getNumSamples();
+
+	//both crossovers read a sample before writing it, so the top band can overwrite the input in place
+	typename decltype(chain.crossover)::BandBlocks bandBlocks;
+	for (int i = 0; i < numBands - 1; ++i)
+	{
+		bandBlocks[static_cast<size_t>(i)] = chain.arena.getBlock(i, numSamples);
+	}
+	bandBlocks[static_cast<size_t>(numBands - 1)] = block;
+
+	auto inputBlock = juce::dsp::AudioBlock<const SampleType>(block);
+	if (linearPhase)
+	{
+		linearPhaseCrossover.process(inputBlock, bandBlocks, numBands);
+	}
+	else
+	{
+		chain.crossover.process(inputBlock, bandBlocks);
+	}
+}
+
+template<typename SampleType>
+void MBDistortionAudioProcessor::processBands(BandChain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block)
+{
+	const auto numSamples = block.getNumSamples();
+
+	//bands only share the summation, so they can run side by side and be added up afterwards
+	//tryRun() declines while the workers are still being started, and the bands run one after another below
+	auto processBand = [&](int i)
+	{
+		auto bandBlock = i == numBands - 1 ? block : chain.arena.getBlock(i, numSamples);
+		chain.bands[static_cast<size_t>(i)].process(juce::dsp::ProcessContextReplacing<SampleType>(bandBlock));
+	};
+	if (parallelBands && numSamples >= minParallelSamples && bandWorkers.tryRun(numBands, processBand))
+	{
+		for (int i = 0; i < numBands - 1; ++i)
+		{
+			block.add(chain.arena.getBlock(i, numSamples));
+		}
+		return;
+	}
+
+	//the top band already sits in the output, every other band is added while it is still in cache.
+	//the add stays a pass of its own: a band's last write comes from the kernel, the down-sampler or the
+	//compensation delay depending on its settings, and the JUCE stages among them can only replace
+	auto outputBlock = block;
+	chain.bands[static_cast<size_t>(numBands - 1)].process(juce::dsp::ProcessContextReplacing<SampleType>(outputBlock));
+
+	for (int i = 0; i < numBands - 1; ++i)
+	{
+		auto bandBlock = chain.arena.getBlock(i, numSamples);
+		chain.bands[static_cast<size_t>(i)].process(juce::dsp::ProcessContextReplacing<SampleType>(bandBlock));
+		block.add(bandBlock);
+	}
+}
+
+template<typename SampleType>
+void MBDistortionAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer)
 {
 	using namespace Params;
 	juce::ScopedNoDenormals noDenormals;
+	RealtimeChecks::ScopedRealtimeCheck realtimeCheck;
 	auto totalNumInputChannels = getTotalNumInputChannels();
 	auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -235,40 +440,67 @@ void MBDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 		buffer.clear(i, 0, buffer.getNumSamples());
 	
 	
-	updateState();
-	leftChannelFifo.update(buffer);
+	if (auto epoch = paramRegistry.getEpoch(); epoch != stateEpoch)
+	{
+		stateEpoch = epoch;
+		updateState(captureSettings());
+		updateLatency();
+	}
 	leftChannelFifo.update(buffer);
-	splitBands(buffer);
-	
-	auto numSamples = buffer.getNumSamples();
-	auto numChannels = buffer.getNumChannels();
-	buffer.clear();
+	rightChannelFifo.update(buffer);
+
+	auto& chain = [this]() -> BandChain<SampleType>&
+	{
+		if constexpr (std::is_same_v<SampleType, double>)
+			return doubleChain;
+		else
+			return floatChain;
+	}();
 
+	auto block = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, static_cast<size_t>(totalNumInputChannels));
+	jassert(block.getNumChannels() <= static_cast<size_t>(chain.arena.getNumChannels()));
 
-	auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
+	//amortized mode runs the DSP once per quantum however small the host's blocks are, for one quantum of latency
+	if (amortizedBlocks)
 	{
-		for (auto i = 0; i < nc; ++i)
+		chain.quantumFifo.process(block, [&](const juce::dsp::AudioBlock<SampleType>& quantum)
 		{
-			inputBuffer.addFrom(i, 0, source, i, 0, ns);
-		}
-	};
-	
-	addFilterBand(buffer, filterBuffers[0]);
-	addFilterBand(buffer, filterBuffers[1]);
-	addFilterBand(buffer, filterBuffers[2]);
-
-	// This is the place where you'd normally do the guts of your plugin's
-	// audio processing...
-	// Make sure to reset the state if your inner loop is processing
-	// the samples and the outer loop is handling the channels.
-	// Alternatively, you can process the samples with the channels
-	// interleaved by keeping the same state.
-	for (int channel = 0; channel < totalNumInputChannels; ++channel)
+			processSamples(chain, quantum);
+		});
+	}
+	else
 	{
-		auto* channelData = buffer.getWritePointer(channel);
+		processSamples(chain, block);
+	}
+}
 
-		// ..do something to the data...
+template<typename SampleType>
+void MBDistortionAudioProcessor::processSamples(BandChain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block)
+{
+	if (updateIdleState(block))
+	{
+		block.clear();
+		return;
 	}
+
+	//a host that breaks its block size promise gets processed in pieces rather than reallocating
+	const auto maxChunk = static_cast<size_t>(chain.arena.getMaxSamples());
+	for (size_t start = 0; start < block.getNumSamples(); start += maxChunk)
+	{
+		auto chunk = block.getSubBlock(start, juce::jmin(maxChunk, block.getNumSamples() - start));
+		splitBands(chain, chunk);
+		processBands(chain, chunk);
+	}
+}
+
+void MBDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+	process(buffer);
+}
+
+void MBDistortionAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+	process(buffer);
 }
 
 //==============================================================================
@@ -332,9 +564,52 @@ juce::AudioProcessorValueTreeState::ParameterLayout MBDistortionAudioProcessor::
 	layout.add(std::make_unique <AudioParameterBool>(params.at(Names::Bypassed_Mid_Band), params.at(Names::Bypassed_Mid_Band), false));
 	layout.add(std::make_unique <AudioParameterBool>(params.at(Names::Bypassed_High_Band), params.at(Names::Bypassed_High_Band), false));
 
+	const auto& oversamplingChoices = GetOversamplingChoices();
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Oversampling_Low_Band), params.at(Names::Oversampling_Low_Band), oversamplingChoices, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Oversampling_Mid_Band), params.at(Names::Oversampling_Mid_Band), oversamplingChoices, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Oversampling_High_Band), params.at(Names::Oversampling_High_Band), oversamplingChoices, 0));
+
+	const auto& shapeChoices = GetShapeChoices();
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Shape_Low_Band), params.at(Names::Shape_Low_Band), shapeChoices, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Shape_Mid_Band), params.at(Names::Shape_Mid_Band), shapeChoices, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Shape_High_Band), params.at(Names::Shape_High_Band), shapeChoices, 0));
+
 	layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Low_Mid_Crossover_Freq), params.at(Names::Low_Mid_Crossover_Freq), NormalisableRange<float>(50, 999, 1, 1), 200));
 	layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Mid_High_Crossover_Freq), params.at(Names::Mid_High_Crossover_Freq), NormalisableRange<float>(1000, 10000, 1, 1), 2000));
 
+	layout.add(std::make_unique<AudioParameterInt>(params.at(Names::Band_Count), params.at(Names::Band_Count), MinBands, MaxBands, DefaultBands));
+
+	//the extra crossovers only matter above three bands, the processor keeps them above the ones below
+	const std::array<float, MaxBands - 3> extraCrossoverDefaults { 5000, 8000, 11000, 14000, 17000 };
+	for (size_t i = 2; i < CrossoverParams.size(); ++i)
+	{
+		const auto& name = params.at(CrossoverParams[i]);
+		layout.add(std::make_unique<AudioParameterFloat>(name, name, NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1, 0.25f), extraCrossoverDefaults[i - 2]));
+	}
+
+	for (size_t band = 3; band < BandParams.size(); ++band)
+	{
+		const auto& names = BandParams[band];
+		layout.add(std::make_unique<AudioParameterFloat>(params.at(names.inputGain), params.at(names.inputGain), gainRange, 0));
+		layout.add(std::make_unique<AudioParameterFloat>(params.at(names.distortion), params.at(names.distortion), driveRange, 0));
+		layout.add(std::make_unique<AudioParameterFloat>(params.at(names.outputGain), params.at(names.outputGain), gainRange, 0));
+		layout.add(std::make_unique<AudioParameterBool>(params.at(names.bypassed), params.at(names.bypassed), false));
+		layout.add(std::make_unique<AudioParameterChoice>(params.at(names.oversampling), params.at(names.oversampling), oversamplingChoices, 0));
+		layout.add(std::make_unique<AudioParameterChoice>(params.at(names.shape), params.at(names.shape), shapeChoices, 0));
+	}
+
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Crossover_Mode), params.at(Names::Crossover_Mode), GetCrossoverModeChoices(), 0));
+	layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Channel_Link), params.at(Names::Channel_Link), false));
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Shaper_Mode), params.at(Names::Shaper_Mode), GetShaperModeChoices(), 0));
+	layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Parallel_Bands), params.at(Names::Parallel_Bands), false));
+	layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Block_Mode), params.at(Names::Block_Mode), GetBlockModeChoices(), 0));
+
+	for (const auto& names : BandParams)
+	{
+		layout.add(std::make_unique<AudioParameterChoice>(params.at(names.stereoMode), params.at(names.stereoMode), GetStereoModeChoices(), 0));
+		layout.add(std::make_unique<AudioParameterFloat>(params.at(names.sideDistortion), params.at(names.sideDistortion), driveRange, 0));
+	}
+
 	return layout;
 }
 
@@ -9,11 +9,18 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "DistortionBand.h"
+#include "Params.h"
+#include "BandChain.h"
+#include "LinearPhaseCrossover.h"
+#include "ShaperTables.h"
+#include "BandWorkers.h"
+#include "RealtimeChecks.h"
 #include "SingleChannelSampleFifo.h"
 //==============================================================================
 
-class MBDistortionAudioProcessor : public juce::AudioProcessor
+class MBDistortionAudioProcessor : public juce::AudioProcessor,
+    private juce::Timer,
+    private juce::AudioProcessorValueTreeState::Listener
 #if JucePlugin_Enable_ARA
     , public juce::AudioProcessorARAExtension
 #endif
@@ -33,6 +40,8 @@ public:
 #endif
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -60,29 +69,83 @@ public:
     using APVTS = juce::AudioProcessorValueTreeState;
     static APVTS::ParameterLayout createParameterLayout();
     APVTS apvts{ *this, nullptr, "Parameters", createParameterLayout() };
+    Params::Registry paramRegistry{ apvts };
 
-    using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
+    SingleChannelSampleFifo leftChannelFifo { Channel::Left };
+    SingleChannelSampleFifo rightChannelFifo { Channel::Right };
 
 private:
-    DistortionBand* p_lowBandDist;
-    DistortionBand* p_midBandDist;
-    DistortionBand* p_highBandDist;
-
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-
-    Filter LP1, AP2,
-        HP1, LP2,
-        HP2;
-
-    juce::AudioParameterFloat* lowMidCrossover { nullptr };
-    juce::AudioParameterFloat* midHighCrossover { nullptr };
-
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
-
-    void updateState();
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    //7.1.4 and the larger discrete layouts fit, the crossover runs them as two groups of eight lanes
+    static constexpr int maxChannels{ 16 };
+
+    //only the chain matching the host's processing precision gets prepared
+    BandChain<float> floatChain;
+    BandChain<double> doubleChain;
+    int numBands{ Params::DefaultBands };
+
+    //always convolves in float, it converts on the way in and out of its FIFO
+    LinearPhaseCrossover linearPhaseCrossover;
+    bool linearPhase{ false };
+
+    Shapers::Mode shaperMode{ Shapers::Mode::direct };
+
+    //below minParallelSamples waking the workers costs more than the bands they would take
+    static constexpr int maxBandWorkers{ 3 };
+    static constexpr size_t minParallelSamples{ 256 };
+    BandWorkers bandWorkers;
+    bool parallelBands{ false };
+
+    //the workers only run while the processor is prepared with parallel bands on, and only the message thread starts
+    //or stops them. a click on the switch does it straight away, automation arriving on the audio thread waits for
+    //the timer; until then tryRun() finds no workers and the bands run serially. the lock keeps both out of prepare/release
+    static constexpr int messageThreadPollHz{ 10 };
+    juce::CriticalSection bandWorkersLock;
+    bool bandWorkersPrepared{ false };
+    void updateBandWorkers();
+    void timerCallback() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    //setLatencySamples locks and calls back into the host, so the audio thread only leaves the new value here
+    //and the timer hands it on from the message thread
+    std::atomic<int> pendingLatency{ 0 };
+    void publishLatency();
+
+    //quantum the amortized block mode re-blocks the host's buffers into
+    static constexpr int processingQuantum{ 256 };
+    bool amortizedBlocks{ false };
+
+    //once the input has been silent for longer than anything can ring, all state is zeroed and the DSP is skipped
+    static constexpr float silenceThreshold{ 1.0e-6f };
+    static constexpr double ringOutSeconds{ 0.2 };
+    int silentSamples{ 0 };
+    int idleHangoverSamples{ 0 };
+    bool idle{ false };
+
+    template<typename SampleType>
+    bool updateIdleState(const juce::dsp::AudioBlock<SampleType>& block);
+    void resetProcessingState();
+
+    //the registry epoch updateState last ran for, so static parameters cost one atomic load per block
+    uint32_t stateEpoch{ 0 };
+
+    //set from isNonRealtime() in prepareToPlay, bounces then override the quality settings the live path uses
+    static constexpr int renderOversampling{ 3 };
+    bool renderProfile{ false };
+
+    Params::Snapshot captureSettings() const;
+    void updateState(const Params::Snapshot& snapshot);
+    void updateLatency();
+    template<typename Fn>
+    void forActiveChain(Fn&& fn);
+
+    template<typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer);
+    template<typename SampleType>
+    void processSamples(BandChain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block);
+    template<typename SampleType>
+    void splitBands(BandChain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block);
+    template<typename SampleType>
+    void processBands(BandChain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block);
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MBDistortionAudioProcessor);
 };
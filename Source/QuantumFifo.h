@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    QuantumFifo.h
+    Created: 17 Oct 2026 7:31:52pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+	Re-blocks whatever the host hands over into fixed-size quanta, at the cost of one quantum of latency.
+
+	A single buffer does both directions: each incoming sample is swapped with the processed sample that
+	sits in its slot, so once the buffer is full it only holds new input and is processed in place.
+*/
+template<typename SampleType>
+struct QuantumFifo
+{
+	void prepare(int numChannels, int quantumSize)
+	{
+		buffer.setSize(numChannels, quantumSize);
+		reset();
+	}
+
+	void reset() noexcept
+	{
+		buffer.clear();
+		position = 0;
+	}
+
+	//processQuantum gets every full quantum as it completes, the block comes back delayed by one quantum
+	template<typename ProcessQuantum>
+	void process(const juce::dsp::AudioBlock<SampleType>& block, ProcessQuantum&& processQuantum)
+	{
+		const auto numChannels = block.getNumChannels();
+		const auto numSamples = block.getNumSamples();
+		const auto quantumSize = static_cast<size_t>(buffer.getNumSamples());
+
+		jassert(numChannels <= static_cast<size_t>(buffer.getNumChannels()));
+
+		size_t done = 0;
+		while (done < numSamples)
+		{
+			const auto numToSwap = juce::jmin(numSamples - done, quantumSize - position);
+
+			for (size_t ch = 0; ch < numChannels; ++ch)
+			{
+				auto* host = block.getChannelPointer(ch) + done;
+				std::swap_ranges(host, host + numToSwap, buffer.getWritePointer(static_cast<int>(ch)) + position);
+			}
+
+			position += numToSwap;
+			done += numToSwap;
+
+			if (position == quantumSize)
+			{
+				position = 0;
+				processQuantum(juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, numChannels));
+			}
+		}
+	}
+private:
+	juce::AudioBuffer<SampleType> buffer;
+	size_t position{ 0 };
+};
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.cpp
+    Created: 17 Oct 2026 7:02:15pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include "RealtimeChecks.h"
+
+#if MBDISTORTION_REALTIME_CHECKS
+
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+namespace
+{
+	//plain thread_locals, so reading them can't allocate
+	thread_local int realtimeDepth = 0;
+	thread_local bool reporting = false;
+	std::atomic<int> numViolations{ 0 };
+	std::atomic<const char*> lastViolation{ "" };
+
+	void* allocate(std::size_t size)
+	{
+		RealtimeChecks::reportViolation("operator new");
+		if (auto* ptr = std::malloc(size > 0 ? size : 1))
+		{
+			return ptr;
+		}
+
+		throw std::bad_alloc();
+	}
+
+	void deallocate(void* ptr) noexcept
+	{
+		if (ptr != nullptr)
+		{
+			RealtimeChecks::reportViolation("operator delete");
+		}
+
+		std::free(ptr);
+	}
+}
+
+namespace RealtimeChecks
+{
+	ScopedRealtimeCheck::ScopedRealtimeCheck() noexcept { ++realtimeDepth; }
+	ScopedRealtimeCheck::~ScopedRealtimeCheck() noexcept { --realtimeDepth; }
+
+	int getNumViolations() noexcept
+	{
+		return numViolations.load(std::memory_order_relaxed);
+	}
+
+	const char* getLastViolation() noexcept
+	{
+		return lastViolation.load(std::memory_order_relaxed);
+	}
+
+	void reportViolation(const char* what) noexcept
+	{
+		//the report allocates too, so nothing it does is reported again
+		if (realtimeDepth == 0 || reporting)
+		{
+			return;
+		}
+
+		reporting = true;
+		numViolations.fetch_add(1, std::memory_order_relaxed);
+		lastViolation.store(what, std::memory_order_relaxed);
+
+		//not DBG, release builds with the checks on have to report too
+		juce::Logger::outputDebugString(juce::String("Real-time violation: ") + what + " on the audio thread\n" + juce::SystemStats::getStackBacktrace());
+		reporting = false;
+	}
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return allocate(size); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return allocate(size); }
+	catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+
+#if JUCE_LINUX
+//only takes effect where this module's symbols come first, the standalone build rather than a plugin dlopen()ed by a host
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+	using LockFunction = int (*)(pthread_mutex_t*);
+	static std::atomic<LockFunction> next{ nullptr };
+
+	auto lock = next.load(std::memory_order_acquire);
+	if (lock == nullptr)
+	{
+		lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+		next.store(lock, std::memory_order_release);
+	}
+
+	RealtimeChecks::reportViolation("pthread_mutex_lock");
+	return lock(mutex);
+}
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.h
+    Created: 17 Oct 2026 7:02:15pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//on by default in debug builds, define it to 0 or 1 in the Projucer to override
+#ifndef MBDISTORTION_REALTIME_CHECKS
+ #define MBDISTORTION_REALTIME_CHECKS JUCE_DEBUG
+#endif
+
+/*
+	Debug instrumentation for the audio thread. While a ScopedRealtimeCheck is alive on a thread, every
+	operator new and delete in this module, and on Linux every pthread mutex lock, is counted and logged
+	with a backtrace of the call site. The checks replace the global allocation operators, so they compile
+	to nothing unless MBDISTORTION_REALTIME_CHECKS is set.
+
+	Only Linux sees locks: Windows' critical sections, events and SRW locks and macOS' os_unfair_lock don't go
+	through anything this module can replace, so there only allocations are caught.
+*/
+namespace RealtimeChecks
+{
+#if MBDISTORTION_REALTIME_CHECKS
+	struct ScopedRealtimeCheck
+	{
+		ScopedRealtimeCheck() noexcept;
+		~ScopedRealtimeCheck() noexcept;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeCheck)
+	};
+
+	//how many violations have been reported since the module was loaded, and what the latest one was
+	int getNumViolations() noexcept;
+	const char* getLastViolation() noexcept;
+
+	//whether taking a lock is counted on this platform, allocations always are
+   #if JUCE_LINUX
+	constexpr bool detectsLocks = true;
+   #else
+	constexpr bool detectsLocks = false;
+   #endif
+
+	void reportViolation(const char* what) noexcept;
+#else
+	struct ScopedRealtimeCheck
+	{
+		ScopedRealtimeCheck() noexcept { }
+	};
+
+	inline int getNumViolations() noexcept { return 0; }
+	inline const char* getLastViolation() noexcept { return ""; }
+	constexpr bool detectsLocks = false;
+#endif
+}
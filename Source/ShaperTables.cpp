@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    ShaperTables.cpp
+    Created: 17 Oct 2026 5:38:26pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include "ShaperTables.h"
+
+namespace
+{
+	struct AllTables
+	{
+		AllTables()
+		{
+			using namespace Shapers;
+
+			tables[static_cast<size_t>(Shape::hardClip)].fill<HardClip>(Shape::hardClip);
+			tables[static_cast<size_t>(Shape::softClip)].fill<SoftClip>(Shape::softClip);
+			tables[static_cast<size_t>(Shape::tanh)].fill<Tanh>(Shape::tanh);
+			tables[static_cast<size_t>(Shape::foldback)].fill<Foldback>(Shape::foldback);
+		}
+
+		std::array<Shapers::Table, 4> tables;
+	};
+
+	//built in place the first time through, after that reaching it is only a check of the initialisation guard
+	const AllTables& getAllTables() noexcept
+	{
+		static const AllTables allTables;
+		return allTables;
+	}
+}
+
+namespace ShaperTables
+{
+	void prepare()
+	{
+		getAllTables();
+	}
+
+	const Shapers::Table& get(Shapers::Shape shape) noexcept
+	{
+		return getAllTables().tables[static_cast<size_t>(shape)];
+	}
+}
@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    ShaperTables.h
+    Created: 17 Oct 2026 5:38:26pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Waveshapers.h"
+
+/*
+	Lookup tables for the band curves, one per shape.
+
+	Drive is applied before the curve, so a table only depends on the shape, and the four of them are shared by
+	every band of every instance. They're built once, the first time anything asks for them, and never change
+	after that, so the audio thread only ever reads them.
+*/
+namespace ShaperTables
+{
+	//builds the tables if nothing has yet, so call it off the audio thread before the first get()
+	void prepare();
+
+	const Shapers::Table& get(Shapers::Shape shape) noexcept;
+}
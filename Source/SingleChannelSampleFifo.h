@@ -10,73 +10,116 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "Fifo.h"
 enum Channel
 {
-    Right, 
-    Left 
+    Right,
+    Left
 };
 
-template<typename BlockType>
+/*
+    Single-producer/single-consumer ring of one channel's raw samples, the audio thread writes and the
+    analyzer reads. Both sides copy whole runs straight between their own buffers and the ring, at most
+    two runs where it wraps, and only publish their position once the samples are in or out. When the
+    analyzer falls behind, the newest samples are dropped rather than overwriting ones it may be reading.
+*/
 struct SingleChannelSampleFifo
 {
     SingleChannelSampleFifo(Channel ch) : channelToUse(ch)
     {
-        prepared.set(false);
+        //allocated once for good, the analysis thread may be reading it whenever the processor is re-prepared
+        ring.assign(ringSize, 0.f);
+        mask = ring.size() - 1;
     }
 
-    void update(const BlockType& buffer)
+    //double precision hosts feed the same float analyzer
+    template<typename SourceBuffer>
+    void update(const SourceBuffer& buffer)
     {
-        jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse);
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        if (!prepared.load(std::memory_order_acquire) || buffer.getNumChannels() == 0)
+            return;
+
+        //mono inputs feed both analyzers from their one channel
+        auto* source = buffer.getReadPointer(juce::jmin(static_cast<int>(channelToUse), buffer.getNumChannels() - 1));
 
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        const auto write = writePosition.load(std::memory_order_relaxed);
+        const auto space = ring.size() - (write - readPosition.load(std::memory_order_acquire));
+        const auto numToWrite = juce::jmin(static_cast<size_t>(buffer.getNumSamples()), space);
+
+        forEachRun(write, numToWrite, [source](size_t done, float* run, size_t runLength)
         {
-            pushNextSampleIntoFifo(channelPtr[i]);
-        }
+            if constexpr (std::is_same_v<std::remove_const_t<std::remove_pointer_t<decltype(source)>>, float>)
+                juce::FloatVectorOperations::copy(run, source + done, static_cast<int>(runLength));
+            else
+                std::transform(source + done, source + done + runLength, run, [](auto sample) { return static_cast<float>(sample); });
+        });
+
+        writePosition.store(write + numToWrite, std::memory_order_release);
     }
 
+    //neither the ring nor the positions change here, each side only ever moves its own position
     void prepare(int bufferSize)
     {
-        prepared.set(false);
         size.set(bufferSize);
-
-        bufferToFill.setSize(1,           
-            bufferSize, 
-            false,        
-            true,          
-            true);         
-        audioBufferFifo.prepare(1, bufferSize);
-        fifoIndex = 0;
-        prepared.set(true);
+        prepared.store(true, std::memory_order_release);
     }
     //==============================================================================
-    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
-    bool isPrepared() const { return prepared.get(); }
+    int getNumSamplesAvailable() const
+    {
+        if (!isPrepared())
+            return 0;
+
+        return static_cast<int>(writePosition.load(std::memory_order_acquire) - readPosition.load(std::memory_order_relaxed));
+    }
+    bool isPrepared() const { return prepared.load(std::memory_order_acquire); }
     int getSize() const { return size.get(); }
     //==============================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
+    //copies the oldest numSamples straight into dest, returns how many there were
+    int read(float* dest, int numSamples)
+    {
+        const auto position = readPosition.load(std::memory_order_relaxed);
+        const auto numToRead = static_cast<size_t>(juce::jlimit(0, getNumSamplesAvailable(), numSamples));
+
+        forEachRun(position, numToRead, [dest](size_t done, float* run, size_t runLength)
+        {
+            juce::FloatVectorOperations::copy(dest + done, run, static_cast<int>(runLength));
+        });
+
+        readPosition.store(position + numToRead, std::memory_order_release);
+        return static_cast<int>(numToRead);
+    }
+
+    //lets the reader jump past samples it has no use for without copying them
+    void discard(int numSamples)
+    {
+        const auto numToDiscard = static_cast<size_t>(juce::jlimit(0, getNumSamplesAvailable(), numSamples));
+        readPosition.store(readPosition.load(std::memory_order_relaxed) + numToDiscard, std::memory_order_release);
+    }
 private:
+    //a few dozen large host blocks, or well over a slow repaint's worth at any sample rate
+    static constexpr size_t ringSize = 1 << 16;
+
     Channel channelToUse;
-    int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
-    juce::Atomic<bool> prepared = false;
+    std::vector<float> ring;
+    size_t mask = 0;
+
+    //running totals rather than indices, so full and empty never look the same
+    std::atomic<size_t> writePosition{ 0 };
+    std::atomic<size_t> readPosition{ 0 };
+
+    std::atomic<bool> prepared{ false };
     juce::Atomic<int> size = 0;
 
-    void pushNextSampleIntoFifo(float sample)
+    //calls fn(offset, run, runLength) for the one or two contiguous runs numSamples from position cover
+    template<typename Fn>
+    void forEachRun(size_t position, size_t numSamples, Fn&& fn)
     {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
+        const auto start = position & mask;
+        const auto firstRun = juce::jmin(numSamples, ring.size() - start);
 
-            juce::ignoreUnused(ok);
+        if (firstRun > 0)
+            fn(size_t{ 0 }, ring.data() + start, firstRun);
 
-            fifoIndex = 0;
-        }
-
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
+        if (numSamples > firstRun)
+            fn(firstRun, ring.data(), numSamples - firstRun);
     }
-};
\ No newline at end of file
+};
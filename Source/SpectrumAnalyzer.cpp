@@ -15,28 +15,13 @@
 #include "LookAndFeel.h"
 SpectrumAnalyzer::SpectrumAnalyzer(MBDistortionAudioProcessor& p) :
 	audioProcessor(p),
-	leftPathProducer(audioProcessor.leftChannelFifo),
-	rightPathProducer(audioProcessor.rightChannelFifo)
+	analyzerThread(audioProcessor)
 {
 	const auto& params = audioProcessor.getParameters();
 	for (auto param : params)
 	{
 		param->addListener(this);
 	}
-	using namespace Params;
-	const auto& paramNames = GetParams();
-
-	auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
-	{
-		param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
-		jassert(param != nullptr);
-	};
-	floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
-	floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
-
-	floatHelper(lowDistParam, Names::Distortion_Low_Band);
-	floatHelper(midDistParam, Names::Distortion_Mid_Band);
-	floatHelper(highDistParam, Names::Distortion_High_Band);
 
 	startTimerHz(60);
 }
@@ -60,17 +45,11 @@ void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int>bo
 	Graphics::ScopedSaveState sss(g);
 	g.reduceClipRegion(responseArea);
 
-	auto leftChannelFFTPath = leftPathProducer.getPath();
-	leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
-
 	g.setColour(ColorScheme::getSliderBorderColor());
-	g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-
-	auto rightChannelFFTPath = rightPathProducer.getPath();
-	rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+	g.strokePath(analyzerThread.getLeftPath(), PathStrokeType(1.f));
 
 	g.setColour(Colour(215u, 201u, 134u));
-	g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+	g.strokePath(analyzerThread.getRightPath(), PathStrokeType(1.f));
 }
 
 void SpectrumAnalyzer::paint(juce::Graphics& g)
@@ -108,20 +87,32 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int>bou
 		auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
 		return left + width * normX;
 	};
-	auto lowMidX = mapX(lowMidXoverParam->get());
-	g.setColour(ColorScheme::getCrossoverColor());
-	g.drawVerticalLine(lowMidX, top, bottom);
+	const auto snapshot = audioProcessor.paramRegistry.capture();
+	const auto crossoverFreqs = Params::GetCrossoverFrequencies(snapshot, audioProcessor.getSampleRate());
+
+	//band edges: the left border, every active crossover, the right border
+	std::array<float, Params::MaxBands + 1> edges;
+	edges[0] = float(left);
+	edges[static_cast<size_t>(snapshot.numBands)] = float(right);
 
-	auto midHighX = mapX(midHighXoverParam->get());
-	g.drawVerticalLine(midHighX, top, bottom);
+	g.setColour(ColorScheme::getCrossoverColor());
+	for (int i = 1; i < snapshot.numBands; ++i)
+	{
+		//where the DSP splits, which isn't where the knob is once it's been pushed apart from its neighbours
+		auto x = mapX(crossoverFreqs[static_cast<size_t>(i - 1)]);
+		g.drawVerticalLine(juce::roundToInt(x), float(top), float(bottom));
+		edges[static_cast<size_t>(i)] = x;
+	}
 
 	auto mapY = [bottom, top](float db) {
 		return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
 	};
 	g.setColour(ColorScheme::getDistColor());
-	g.drawHorizontalLine(mapY(lowDistParam->get()/1.05f-72), left, lowMidX);
-	g.drawHorizontalLine(mapY(midDistParam->get() / 1.05f - 72), lowMidX, midHighX);
-	g.drawHorizontalLine(mapY(highDistParam->get() / 1.05f - 72), midHighX, right);
+	for (int i = 0; i < snapshot.numBands; ++i)
+	{
+		auto band = static_cast<size_t>(i);
+		g.drawHorizontalLine(juce::roundToInt(mapY(snapshot.bands[band].drive / 1.05f - 72)), edges[band], edges[band + 1]);
+	}
 }
 
 std::vector<float> SpectrumAnalyzer::getFrequencies()
@@ -273,8 +264,11 @@ void SpectrumAnalyzer::resized()
 	auto bounds = getLocalBounds();
 	auto fftBounds = getAnalysisArea(bounds).toFloat();
 	auto negInf = jmap(bounds.toFloat().getBottom(), fftBounds.getBottom(), fftBounds.getY(), NEGATIVE_INFINITY, MAX_DECIBELS);
-	leftPathProducer.updateNegativeInfinity(negInf);
-	rightPathProducer.updateNegativeInfinity(negInf);
+
+	//paint draws inside the module border, so the paths start where that analysis area does
+	auto responseArea = getAnalysisArea(bounds.reduced(3));
+	fftBounds.setBottom(bounds.toFloat().getBottom());
+	analyzerThread.setBounds(fftBounds.withX(float(responseArea.getX())), negInf);
 
 }
 
@@ -285,23 +279,13 @@ void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
 
 void SpectrumAnalyzer::timerCallback()
 {
-	if (shouldShowFFTAnalysis)
-	{
-		auto bounds = getLocalBounds();
-		auto fftBounds = getAnalysisArea(bounds).toFloat();
-		fftBounds.setBottom(getLocalBounds().getBottom());
-		auto sampleRate = audioProcessor.getSampleRate();
-
-		leftPathProducer.process(fftBounds, sampleRate);
-		rightPathProducer.process(fftBounds, sampleRate);
-	}
+	//the analysis thread has done the work, all that's left here is picking up its paths
+	auto newPaths = shouldShowFFTAnalysis && analyzerThread.pullPaths();
 
-	if (parametersChanged.compareAndSetBool(false, true))
+	if (parametersChanged.compareAndSetBool(false, true) || newPaths)
 	{
-
+		repaint();
 	}
-
-	repaint();
 }
 
 juce::Rectangle<int> SpectrumAnalyzer::getRenderArea(juce::Rectangle<int> bounds)
@@ -10,7 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "PathProducer.h"
+#include "AnalyzerThread.h"
 struct SpectrumAnalyzer : juce::Component,
     juce::AudioProcessorParameter::Listener,
     juce::Timer
@@ -30,6 +30,8 @@ struct SpectrumAnalyzer : juce::Component,
     void toggleAnalysisEnablement(bool enabled)
     {
         shouldShowFFTAnalysis = enabled;
+        analyzerThread.setEnabled(enabled);
+        repaint();
     }
 private:
     MBDistortionAudioProcessor& audioProcessor;
@@ -49,20 +51,10 @@ private:
 
     juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
 
-    PathProducer leftPathProducer, rightPathProducer; 
+    //makes the paths, paint only strokes them
+    AnalyzerThread analyzerThread;
 
     void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int>bounds);
 
     void drawCrossovers(juce::Graphics& g, juce::Rectangle<int>bounds);
-
-    juce::AudioParameterFloat* lowMidXoverParam {nullptr };
-    juce::AudioParameterFloat* midHighXoverParam {nullptr };
-
-    juce::AudioParameterFloat* lowDistParam {nullptr };
-    juce::AudioParameterFloat* midDistParam {nullptr };
-    juce::AudioParameterFloat* highDistParam {nullptr };
-    
-
-
-
 };
\ No newline at end of file
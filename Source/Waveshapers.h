@@ -0,0 +1,928 @@
+/*
+  ==============================================================================
+
+    Waveshapers.h
+    Created: 17 Oct 2026 10:12:04am
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterRamp.h"
+
+namespace Shapers
+{
+	enum class Shape
+	{
+		hardClip,
+		softClip,
+		tanh,
+		foldback,
+	};
+
+	//how the curve is evaluated, the result is the same either way up to the table's interpolation error
+	enum class Mode
+	{
+		direct,
+		lookupTable,
+		firstOrderADAA,
+		secondOrderADAA,
+	};
+
+	//which part of a stereo pair goes through the curve, the rest only gets the band's input and output gain
+	enum class StereoMode
+	{
+		stereo,
+		mid,
+		side,
+		midSide,
+	};
+
+#if JUCE_USE_SIMD
+	template<typename T>
+	using Register = juce::dsp::SIMDRegister<T>;
+#endif
+
+	//every curve takes the drive-scaled input and saturates towards +-1
+	//tableRange is the span a lookup table has to cover, beyond it the curve holds its end values or, with tableWraps, repeats.
+	//antiderivatives is how many closed-form antiderivatives the curve provides for ADAA
+	struct HardClip
+	{
+		static constexpr bool hasSIMDPath = true;
+		static constexpr double tableRange = 1.0;
+		static constexpr bool tableWraps = false;
+		static constexpr int antiderivatives = 2;
+
+		static double antiderivative1(double x) noexcept
+		{
+			auto a = std::abs(x);
+			return a <= 1.0 ? 0.5 * x * x : a - 0.5;
+		}
+
+		static double antiderivative2(double x) noexcept
+		{
+			auto a = std::abs(x);
+			return a <= 1.0 ? x * x * x / 6.0 : std::copysign(0.5 * x * x - 0.5 * a + 1.0 / 6.0, x);
+		}
+
+		template<typename T>
+		static T apply(T x) noexcept
+		{
+			return juce::jlimit(T(-1), T(1), x);
+		}
+
+#if JUCE_USE_SIMD
+		template<typename T>
+		static Register<T> apply(Register<T> x) noexcept
+		{
+			return Register<T>::min(Register<T>::expand(T(1)), Register<T>::max(Register<T>::expand(T(-1)), x));
+		}
+#endif
+	};
+
+	struct SoftClip
+	{
+		static constexpr bool hasSIMDPath = true;
+		static constexpr double tableRange = 1.0;
+		static constexpr bool tableWraps = false;
+		static constexpr int antiderivatives = 2;
+
+		static double antiderivative1(double x) noexcept
+		{
+			auto a = std::abs(x);
+			return a <= 1.0 ? 0.75 * x * x - 0.125 * x * x * x * x : a - 0.375;
+		}
+
+		static double antiderivative2(double x) noexcept
+		{
+			auto a = std::abs(x);
+			return a <= 1.0 ? 0.25 * x * x * x - 0.025 * x * x * x * x * x : std::copysign(0.5 * x * x - 0.375 * a + 0.1, x);
+		}
+
+		template<typename T>
+		static T apply(T x) noexcept
+		{
+			x = juce::jlimit(T(-1), T(1), x);
+			return T(1.5) * x - T(0.5) * x * x * x;
+		}
+
+#if JUCE_USE_SIMD
+		template<typename T>
+		static Register<T> apply(Register<T> x) noexcept
+		{
+			x = HardClip::apply(x);
+			return x * (Register<T>::expand(T(1.5)) - Register<T>::expand(T(0.5)) * x * x);
+		}
+#endif
+	};
+
+	struct Tanh
+	{
+		static constexpr bool hasSIMDPath = false;
+		static constexpr double tableRange = 8.0;      //tanh(8) is within 2.3e-7 of 1
+		static constexpr bool tableWraps = false;
+		static constexpr int antiderivatives = 1;      //the second one needs a dilogarithm
+
+		//log(cosh(x)), written so it can't overflow
+		static double antiderivative1(double x) noexcept
+		{
+			auto a = std::abs(x);
+			constexpr auto ln2 = 0.69314718055994530942;
+			return a - ln2 + std::log1p(std::exp(-2.0 * a));
+		}
+
+		template<typename T>
+		static T apply(T x) noexcept
+		{
+			return std::tanh(x);
+		}
+	};
+
+	struct Foldback
+	{
+		static constexpr bool hasSIMDPath = false;
+		static constexpr double tableRange = 2.0;      //one period
+		static constexpr bool tableWraps = true;
+		static constexpr int antiderivatives = 0;
+
+		template<typename T>
+		static T apply(T x) noexcept
+		{
+			//triangle wave that reflects anything beyond +-1 back into range
+			auto t = T(0.25) * x + T(0.25);
+			return T(4) * std::abs(t - std::floor(t + T(0.5))) - T(1);
+		}
+	};
+
+	inline int getNumAntiderivatives(Shape shape) noexcept
+	{
+		switch (shape)
+		{
+		case Shape::hardClip: return HardClip::antiderivatives;
+		case Shape::softClip: return SoftClip::antiderivatives;
+		case Shape::tanh: return Tanh::antiderivatives;
+		case Shape::foldback: return Foldback::antiderivatives;
+		}
+
+		return 0;
+	}
+
+	//one curve sampled on a uniform grid over [-range, range], read back with linear interpolation
+	struct Table
+	{
+		//4096 intervals put +-1 on the grid for every range above, so the kinks of the clippers are exact
+		static constexpr int size = 4097;
+
+		Shape shape{ Shape::hardClip };
+		float range{ 1.f };
+		float inverseSpan{ 0.5f };
+		bool wraps{ false };
+
+		//one guard point past the end so the interpolation never needs a bounds check
+		std::array<float, size + 1> values{};
+
+		template<typename T>
+		T lookup(T x) const noexcept
+		{
+			auto position = (x + static_cast<T>(range)) * static_cast<T>(inverseSpan);
+			if (wraps)
+			{
+				position -= std::floor(position);
+			}
+
+			position = juce::jlimit(T(0), T(1), position) * T(size - 1);
+			const auto index = static_cast<size_t>(position);
+			const auto fraction = position - static_cast<T>(index);
+			const auto a = static_cast<T>(values[index]);
+			return a + (static_cast<T>(values[index + 1]) - a) * fraction;
+		}
+
+		template<typename Shaper>
+		void fill(Shape newShape) noexcept
+		{
+			shape = newShape;
+			range = static_cast<float>(Shaper::tableRange);
+			inverseSpan = static_cast<float>(0.5 / Shaper::tableRange);
+			wraps = Shaper::tableWraps;
+
+			for (int i = 0; i < size; ++i)
+			{
+				auto x = -Shaper::tableRange + 2.0 * Shaper::tableRange * i / (size - 1);
+				values[static_cast<size_t>(i)] = static_cast<float>(Shaper::apply(x));
+			}
+			values[size] = values[size - 1];
+		}
+	};
+
+	//history of one channel for the ADAA shapers, zero is silence for every curve
+	struct AntiderivativeState
+	{
+		double x1{ 0.0 }, x2{ 0.0 };      //the previous two inputs
+		double f1{ 0.0 };                  //the highest antiderivative in use at x1
+		double d1{ 0.0 };                  //second order only, the previous first difference
+	};
+
+	/*
+		Antiderivative anti-aliasing: instead of sampling the curve, each output is the curve averaged over the
+		segment between consecutive inputs (second order: a triangle-weighted average over the last three),
+		which behaves like a lowpass on the harmonics that would otherwise fold back. First order delays the
+		band by half a sample, second order by one. Curves without enough antiderivatives drop to the highest
+		order they support. All of it runs in double, the divided differences cancel badly in float.
+	*/
+	template<typename Shaper, int Order>
+	struct Antiderivative
+	{
+		static constexpr bool hasSIMDPath = false;
+		static constexpr int order = std::min(Order, Shaper::antiderivatives);
+		static constexpr double tolerance = 1.0e-5;
+
+		AntiderivativeState& state;
+
+		template<typename T>
+		T apply(T input) const noexcept
+		{
+			if constexpr (order == 0)
+			{
+				return Shaper::apply(input);
+			}
+			else if constexpr (order == 1)
+			{
+				const auto x = static_cast<double>(input);
+				const auto f1 = Shaper::antiderivative1(x);
+				const auto dx = x - state.x1;
+				const auto y = std::abs(dx) < tolerance ? Shaper::apply(0.5 * (x + state.x1)) : (f1 - state.f1) / dx;
+
+				state.x1 = x;
+				state.f1 = f1;
+				return static_cast<T>(y);
+			}
+			else
+			{
+				const auto x = static_cast<double>(input);
+				const auto f2 = Shaper::antiderivative2(x);
+				const auto dx = x - state.x1;
+				const auto d1 = std::abs(dx) < tolerance ? Shaper::antiderivative1(0.5 * (x + state.x1)) : (f2 - state.f1) / dx;
+
+				auto y = 0.0;
+				const auto span = x - state.x2;
+				if (std::abs(span) < tolerance)
+				{
+					//x and x2 coincide, so average around their midpoint instead
+					const auto midpoint = 0.5 * (x + state.x2);
+					const auto delta = midpoint - state.x1;
+					y = std::abs(delta) < tolerance
+						? Shaper::apply(0.5 * (midpoint + state.x1))
+						: 2.0 / delta * (Shaper::antiderivative1(midpoint) + (state.f1 - Shaper::antiderivative2(midpoint)) / delta);
+				}
+				else
+				{
+					y = 2.0 / span * (d1 - state.d1);
+				}
+
+				state.x2 = state.x1;
+				state.x1 = x;
+				state.f1 = f2;
+				state.d1 = d1;
+				return static_cast<T>(y);
+			}
+		}
+	};
+
+	/*
+		What Antiderivative<Shaper, Order> does to a straight line: the mean of the last Order + 1 inputs. The
+		half of a mid/side pair that isn't shaped goes through it, so it's delayed by the same half or whole
+		sample as the shaped half and the two stay aligned when they're decoded.
+	*/
+	template<int Order>
+	struct LinearAverage
+	{
+		static constexpr bool hasSIMDPath = false;
+
+		AntiderivativeState& state;
+
+		template<typename T>
+		T apply(T input) const noexcept
+		{
+			if constexpr (Order == 0)
+			{
+				return input;
+			}
+			else if constexpr (Order == 1)
+			{
+				const auto x = static_cast<double>(input);
+				const auto y = 0.5 * (x + state.x1);
+				state.x1 = x;
+				return static_cast<T>(y);
+			}
+			else
+			{
+				const auto x = static_cast<double>(input);
+				const auto y = (x + state.x1 + state.x2) / 3.0;
+				state.x2 = state.x1;
+				state.x1 = x;
+				return static_cast<T>(y);
+			}
+		}
+	};
+
+	//lets a table stand in for a curve in the kernels below
+	struct Lookup
+	{
+		static constexpr bool hasSIMDPath = false;
+
+		const Table& table;
+
+		template<typename T>
+		T apply(T x) const noexcept
+		{
+			return table.lookup(x);
+		}
+	};
+}
+
+//input gain, drive, the curve, clipping make-up and output gain in a single pass over the block
+template<typename SampleType>
+struct DistortionKernel
+{
+	DistortionKernel()
+	{
+		inputGain.snapTo(SampleType(1));
+		driveScale.snapTo(SampleType(1) / SampleType(10) / clipping);
+		sideDriveScale.snapTo(SampleType(1) / SampleType(10) / clipping);
+		outputGain.snapTo(SampleType(1));
+	}
+
+	//the ramps run at the host rate even when process() sees oversampled blocks
+	void prepare(const juce::dsp::ProcessSpec& spec)
+	{
+		inputGain.prepare(spec.sampleRate, rampLengthSeconds);
+		driveScale.prepare(spec.sampleRate, rampLengthSeconds);
+		sideDriveScale.prepare(spec.sampleRate, rampLengthSeconds);
+		outputGain.prepare(spec.sampleRate, rampLengthSeconds);
+
+		antiderivativeStates.assign(spec.numChannels, {});
+	}
+
+	void reset() noexcept
+	{
+		inputGain.snapToTarget();
+		driveScale.snapToTarget();
+		sideDriveScale.snapToTarget();
+		outputGain.snapToTarget();
+		inScale = { inputGain.getCurrent() * driveScale.getCurrent(), inputGain.getCurrent() * driveScale.getCurrent() };
+		sideInScale = { inputGain.getCurrent() * sideDriveScale.getCurrent(), inputGain.getCurrent() * sideDriveScale.getCurrent() };
+		passScale = { inputGain.getCurrent(), inputGain.getCurrent() };
+		outScale = { outputGain.getCurrent(), outputGain.getCurrent() };
+		clearAntiderivativeHistory();
+	}
+
+	void setShape(Shapers::Shape newShape) noexcept
+	{
+		//the history holds the old curve's antiderivatives, differencing them against the new one's would spike
+		if (newShape != shape)
+		{
+			shape = newShape;
+			clearAntiderivativeHistory();
+		}
+	}
+
+	//null evaluates the curve directly, and so does a table built for a different shape
+	void setTable(const Shapers::Table* newTable) noexcept { table = newTable; }
+
+	//only stereo blocks have a mid and a side, wider layouts are shaped per channel whatever the mode
+	void setStereoMode(Shapers::StereoMode newMode) noexcept
+	{
+		//the ADAA histories switch between left/right and mid/side
+		if (newMode != stereoMode)
+		{
+			stereoMode = newMode;
+			clearAntiderivativeHistory();
+		}
+	}
+
+	void setMode(Shapers::Mode newMode) noexcept
+	{
+		//the ADAA history of one order means nothing to the other
+		if (newMode != mode)
+		{
+			mode = newMode;
+			clearAntiderivativeHistory();
+		}
+	}
+
+	//linked channels all get the gain the curve applies to the loudest of them, so the image stays put
+	void setChannelLink(bool shouldLink) noexcept { channelLink = shouldLink; }
+
+	void setInputGainDecibels(SampleType gainInDecibels) noexcept
+	{
+		inputGain.setTarget(juce::Decibels::decibelsToGain(gainInDecibels));
+	}
+
+	//the original curve clipped at +-clipping and made the level back up by 1/clipping
+	void setDrive(SampleType driveInGain) noexcept { driveScale.setTarget(driveInGain / SampleType(10) / clipping); }
+
+	//the side's drive in M/S mode, everywhere else the side shares the band's drive
+	void setSideDrive(SampleType driveInGain) noexcept { sideDriveScale.setTarget(driveInGain / SampleType(10) / clipping); }
+
+	void setOutputGainDecibels(SampleType gainInDecibels) noexcept
+	{
+		outputGain.setTarget(juce::Decibels::decibelsToGain(gainInDecibels));
+	}
+
+	//the group delay the ADAA averaging adds at the rate process() runs at, half a sample per order the curve supports.
+	//linked channels and tables stay direct, see process()
+	double getLatencyInSamples() const noexcept
+	{
+		if (mode != Shapers::Mode::firstOrderADAA && mode != Shapers::Mode::secondOrderADAA)
+			return 0.0;
+
+		const auto numChannels = antiderivativeStates.size();
+		const auto midSide = stereoMode != Shapers::StereoMode::stereo && numChannels == 2;
+		if (channelLink && numChannels > 1 && !midSide)
+			return 0.0;
+
+		const auto order = mode == Shapers::Mode::secondOrderADAA ? 2 : 1;
+		return 0.5 * std::min(order, Shapers::getNumAntiderivatives(shape));
+	}
+
+	//moves the ramps on by one host block, process() then spreads that segment over however many samples it gets
+	void advance(int numSamples) noexcept
+	{
+		auto in = inputGain.advance(numSamples);
+		auto drive = driveScale.advance(numSamples);
+		auto sideDrive = sideDriveScale.advance(numSamples);
+		inScale = { in.start * drive.start, in.end * drive.end };
+		sideInScale = { in.start * sideDrive.start, in.end * sideDrive.end };
+		passScale = in;
+		outScale = outputGain.advance(numSamples);
+	}
+
+	template<typename ProcessContext>
+	void process(const ProcessContext& context) noexcept
+	{
+		auto&& inBlock = context.getInputBlock();
+		auto&& outBlock = context.getOutputBlock();
+
+		jassert(inBlock.getNumChannels() == outBlock.getNumChannels());
+		jassert(inBlock.getNumSamples() == outBlock.getNumSamples());
+
+		if (context.isBypassed)
+		{
+			if (context.usesSeparateInputAndOutputBlocks())
+				outBlock.copyFrom(inBlock);
+
+			return;
+		}
+
+		const auto numSamples = outBlock.getNumSamples();
+
+		if (stereoMode != Shapers::StereoMode::stereo && outBlock.getNumChannels() == 2)
+		{
+			processMidSide(inBlock.getChannelPointer(0), inBlock.getChannelPointer(1), outBlock.getChannelPointer(0), outBlock.getChannelPointer(1), numSamples);
+			return;
+		}
+
+		//a table has no SIMD path, so the ramped loop covers the static case too
+		if (table != nullptr && table->shape == shape)
+		{
+			forgetAntiderivativeHistory();
+			const Shapers::Lookup lookup{ *table };
+
+			if (channelLink && outBlock.getNumChannels() > 1)
+			{
+				if (context.usesSeparateInputAndOutputBlocks())
+					outBlock.copyFrom(inBlock);
+
+				shapeLinkedSamples(lookup, outBlock, inScale.start, inScale.getIncrement(numSamples), outScale.start, outScale.getIncrement(numSamples));
+				return;
+			}
+
+			for (size_t ch = 0; ch < outBlock.getNumChannels(); ++ch)
+			{
+				shapeSamplesRamped(lookup, inBlock.getChannelPointer(ch), outBlock.getChannelPointer(ch), numSamples,
+					inScale.start, inScale.getIncrement(numSamples), outScale.start, outScale.getIncrement(numSamples));
+			}
+			return;
+		}
+
+		//linked channels share one gain computed from their peak, which has nothing for ADAA to smooth, so they stay direct
+		const auto antialiased = mode == Shapers::Mode::firstOrderADAA || mode == Shapers::Mode::secondOrderADAA;
+		if (antialiased && !(channelLink && outBlock.getNumChannels() > 1))
+		{
+			jassert(outBlock.getNumChannels() <= antiderivativeStates.size());
+			antiderivativeHistoryInUse = true;
+
+			const auto kernel = getAntiderivativeKernels(mode)[static_cast<size_t>(shape)];
+			for (size_t ch = 0; ch < outBlock.getNumChannels(); ++ch)
+			{
+				kernel(antiderivativeStates[ch], inBlock.getChannelPointer(ch), outBlock.getChannelPointer(ch), numSamples,
+					inScale.start, inScale.getIncrement(numSamples), outScale.start, outScale.getIncrement(numSamples));
+			}
+			return;
+		}
+
+		//whatever ADAA remembers stops following the signal here, so it mustn't be picked up again later
+		forgetAntiderivativeHistory();
+
+		//one indirect call covers every linked channel, they have to be walked together to find their peak
+		if (channelLink && outBlock.getNumChannels() > 1)
+		{
+			if (context.usesSeparateInputAndOutputBlocks())
+				outBlock.copyFrom(inBlock);
+
+			const auto kernel = getLinkedKernels()[static_cast<size_t>(shape)];
+			kernel(outBlock, inScale.start, inScale.getIncrement(numSamples), outScale.start, outScale.getIncrement(numSamples));
+			return;
+		}
+
+		//one indirect call per channel, the per-sample loop is fully inlined for each shape
+		if (inScale.isStatic() && outScale.isStatic())
+		{
+			const auto kernel = getKernels()[static_cast<size_t>(shape)];
+
+			for (size_t ch = 0; ch < outBlock.getNumChannels(); ++ch)
+			{
+				kernel(inBlock.getChannelPointer(ch), outBlock.getChannelPointer(ch), numSamples, inScale.end, outScale.end);
+			}
+		}
+		else
+		{
+			const auto kernel = getRampedKernels()[static_cast<size_t>(shape)];
+			const auto inStep = inScale.getIncrement(numSamples);
+			const auto outStep = outScale.getIncrement(numSamples);
+
+			for (size_t ch = 0; ch < outBlock.getNumChannels(); ++ch)
+			{
+				kernel(inBlock.getChannelPointer(ch), outBlock.getChannelPointer(ch), numSamples, inScale.start, inStep, outScale.start, outStep);
+			}
+		}
+	}
+private:
+	static constexpr SampleType clipping{ SampleType(0.5) };
+	static constexpr double rampLengthSeconds{ 0.02 };
+
+	Shapers::Shape shape{ Shapers::Shape::hardClip };
+	const Shapers::Table* table{ nullptr };
+	Shapers::Mode mode{ Shapers::Mode::direct };
+	Shapers::StereoMode stereoMode{ Shapers::StereoMode::stereo };
+	std::vector<Shapers::AntiderivativeState> antiderivativeStates;
+	bool antiderivativeHistoryInUse{ false };
+	bool channelLink{ false };
+	ParameterRamp<SampleType> inputGain, driveScale, sideDriveScale, outputGain;
+	RampSegment<SampleType> inScale{ SampleType(1) / SampleType(10) / clipping, SampleType(1) / SampleType(10) / clipping };
+	RampSegment<SampleType> sideInScale{ SampleType(1) / SampleType(10) / clipping, SampleType(1) / SampleType(10) / clipping };
+	RampSegment<SampleType> passScale{ SampleType(1), SampleType(1) };      //input gain alone, for the unshaped half in mid or side mode
+	RampSegment<SampleType> outScale{ SampleType(1), SampleType(1) };
+
+	using Kernel = void (*)(const SampleType*, SampleType*, size_t, SampleType, SampleType);
+	using RampedKernel = void (*)(const SampleType*, SampleType*, size_t, SampleType, SampleType, SampleType, SampleType);
+	using LinkedKernel = void (*)(const juce::dsp::AudioBlock<SampleType>&, SampleType, SampleType, SampleType, SampleType);
+	using AntiderivativeKernel = void (*)(Shapers::AntiderivativeState&, const SampleType*, SampleType*, size_t, SampleType, SampleType, SampleType, SampleType);
+
+	void clearAntiderivativeHistory() noexcept
+	{
+		std::fill(antiderivativeStates.begin(), antiderivativeStates.end(), Shapers::AntiderivativeState{});
+		antiderivativeHistoryInUse = false;
+	}
+
+	//called by every path that doesn't run ADAA, only the first block after one that did pays for the clear
+	void forgetAntiderivativeHistory() noexcept
+	{
+		if (antiderivativeHistoryInUse)
+			clearAntiderivativeHistory();
+	}
+
+	//encode, shape and decode in one pass, reading both inputs before writing either output so it also works in place
+	void processMidSide(const SampleType* inLeft, const SampleType* inRight, SampleType* outLeft, SampleType* outRight, size_t numSamples) noexcept
+	{
+		//the half that isn't shaped skips the drive as well as the curve, it's only the band's gain
+		const auto& midScale = stereoMode == Shapers::StereoMode::side ? passScale : inScale;
+		const auto& sideScale = stereoMode == Shapers::StereoMode::mid ? passScale
+			: stereoMode == Shapers::StereoMode::midSide ? sideInScale : inScale;
+
+		const auto midStep = midScale.getIncrement(numSamples);
+		const auto sideStep = sideScale.getIncrement(numSamples);
+		const auto outStep = outScale.getIncrement(numSamples);
+
+		withMidSideShapers([&](const auto& midShaper, const auto& sideShaper)
+		{
+			for (size_t i = 0; i < numSamples; ++i)
+			{
+				auto position = static_cast<SampleType>(i + 1);
+				auto gain = outScale.start + outStep * position;
+				auto mid = (inLeft[i] + inRight[i]) * SampleType(0.5);
+				auto side = (inLeft[i] - inRight[i]) * SampleType(0.5);
+
+				mid = midShaper.apply(mid * (midScale.start + midStep * position)) * gain;
+				side = sideShaper.apply(side * (sideScale.start + sideStep * position)) * gain;
+
+				outLeft[i] = mid + side;
+				outRight[i] = mid - side;
+			}
+		});
+	}
+
+	//calls fn with a mid and a side shaper for the current shape and mode, each with its own ADAA history
+	template<typename Fn>
+	void withMidSideShapers(Fn&& fn) noexcept
+	{
+		if (table != nullptr && table->shape == shape)
+		{
+			forgetAntiderivativeHistory();
+			withPassThrough(Shapers::Lookup{ *table }, Shapers::Lookup{ *table }, Shapers::LinearAverage<0>{ antiderivativeStates[0] },
+				Shapers::LinearAverage<0>{ antiderivativeStates[1] }, fn);
+			return;
+		}
+
+		switch (shape)
+		{
+		case Shapers::Shape::hardClip:
+			withMidSideShapersFor<Shapers::HardClip>(fn);
+			break;
+		case Shapers::Shape::softClip:
+			withMidSideShapersFor<Shapers::SoftClip>(fn);
+			break;
+		case Shapers::Shape::tanh:
+			withMidSideShapersFor<Shapers::Tanh>(fn);
+			break;
+		case Shapers::Shape::foldback:
+			withMidSideShapersFor<Shapers::Foldback>(fn);
+			break;
+		}
+	}
+
+	template<typename Shaper, typename Fn>
+	void withMidSideShapersFor(Fn& fn) noexcept
+	{
+		jassert(antiderivativeStates.size() >= 2);
+		auto& midState = antiderivativeStates[0];
+		auto& sideState = antiderivativeStates[1];
+
+		if (mode == Shapers::Mode::firstOrderADAA || mode == Shapers::Mode::secondOrderADAA)
+		{
+			antiderivativeHistoryInUse = true;
+			if (mode == Shapers::Mode::firstOrderADAA)
+				withAntiderivativeShapers<Shaper, 1>(midState, sideState, fn);
+			else
+				withAntiderivativeShapers<Shaper, 2>(midState, sideState, fn);
+		}
+		else
+		{
+			forgetAntiderivativeHistory();
+			withPassThrough(Shaper{}, Shaper{}, Shapers::LinearAverage<0>{ midState }, Shapers::LinearAverage<0>{ sideState }, fn);
+		}
+	}
+
+	//the pass-through half averages as many samples as the curve's ADAA does, which may be fewer than asked for
+	template<typename Shaper, int Order, typename Fn>
+	void withAntiderivativeShapers(Shapers::AntiderivativeState& midState, Shapers::AntiderivativeState& sideState, Fn& fn) noexcept
+	{
+		using Antialiased = Shapers::Antiderivative<Shaper, Order>;
+		using PassThrough = Shapers::LinearAverage<Antialiased::order>;
+		withPassThrough(Antialiased{ midState }, Antialiased{ sideState }, PassThrough{ midState }, PassThrough{ sideState }, fn);
+	}
+
+	//hands fn the shaped or the pass-through version of each half, whichever the stereo mode asks for
+	template<typename MidShaper, typename SideShaper, typename MidPass, typename SidePass, typename Fn>
+	void withPassThrough(const MidShaper& midShaper, const SideShaper& sideShaper, const MidPass& midPass, const SidePass& sidePass, Fn& fn) noexcept
+	{
+		switch (stereoMode)
+		{
+		case Shapers::StereoMode::mid:
+			fn(midShaper, sidePass);
+			break;
+		case Shapers::StereoMode::side:
+			fn(midPass, sideShaper);
+			break;
+		default:
+			fn(midShaper, sideShaper);
+			break;
+		}
+	}
+
+	//the kernel tables only hold stateless curves, these bind one to the signatures above
+	template<typename Shaper>
+	static void processSamples(const SampleType* input, SampleType* output, size_t numSamples, SampleType inScale, SampleType outScale) noexcept
+	{
+		shapeSamples(Shaper{}, input, output, numSamples, inScale, outScale);
+	}
+
+	template<typename Shaper>
+	static void processSamplesRamped(const SampleType* input, SampleType* output, size_t numSamples,
+		SampleType inStart, SampleType inStep, SampleType outStart, SampleType outStep) noexcept
+	{
+		shapeSamplesRamped(Shaper{}, input, output, numSamples, inStart, inStep, outStart, outStep);
+	}
+
+	template<typename Shaper>
+	static void processLinkedSamples(const juce::dsp::AudioBlock<SampleType>& block,
+		SampleType inStart, SampleType inStep, SampleType outStart, SampleType outStep) noexcept
+	{
+		shapeLinkedSamples(Shaper{}, block, inStart, inStep, outStart, outStep);
+	}
+
+	template<typename Shaper, int Order>
+	static void processAntiderivativeSamples(Shapers::AntiderivativeState& state, const SampleType* input, SampleType* output, size_t numSamples,
+		SampleType inStart, SampleType inStep, SampleType outStart, SampleType outStep) noexcept
+	{
+		shapeSamplesRamped(Shapers::Antiderivative<Shaper, Order>{ state }, input, output, numSamples, inStart, inStep, outStart, outStep);
+	}
+
+	template<typename Shaper>
+	static void shapeSamples(const Shaper& shaper, const SampleType* input, SampleType* output, size_t numSamples, SampleType inScale, SampleType outScale) noexcept
+	{
+		size_t i = 0;
+
+#if JUCE_USE_SIMD
+		if constexpr (Shaper::hasSIMDPath)
+		{
+			using Reg = Shapers::Register<SampleType>;
+			constexpr auto width = Reg::size();
+
+			//scalar head up to the first register boundary, only worth it when input and output line up the same way
+			auto head = juce::jmin(numSamples, static_cast<size_t>(Reg::getNextSIMDAlignedPtr(output) - output));
+			if (!Reg::isSIMDAligned(input + head))
+			{
+				head = numSamples;
+			}
+
+			for (; i < head; ++i)
+			{
+				output[i] = shaper.apply(input[i] * inScale) * outScale;
+			}
+
+			const auto inReg = Reg::expand(inScale);
+			const auto outReg = Reg::expand(outScale);
+
+			for (; i + width <= numSamples; i += width)
+			{
+				(shaper.apply(Reg::fromRawArray(input + i) * inReg) * outReg).copyToRawArray(output + i);
+			}
+		}
+#endif
+
+		for (; i < numSamples; ++i)
+		{
+			output[i] = shaper.apply(input[i] * inScale) * outScale;
+		}
+	}
+
+	//same as shapeSamples, with both scales moving by a fixed step every sample
+	template<typename Shaper>
+	static void shapeSamplesRamped(const Shaper& shaper, const SampleType* input, SampleType* output, size_t numSamples,
+		SampleType inStart, SampleType inStep, SampleType outStart, SampleType outStep) noexcept
+	{
+		size_t i = 0;
+
+#if JUCE_USE_SIMD
+		if constexpr (Shaper::hasSIMDPath)
+		{
+			using Reg = Shapers::Register<SampleType>;
+			constexpr auto width = Reg::size();
+
+			auto head = juce::jmin(numSamples, static_cast<size_t>(Reg::getNextSIMDAlignedPtr(output) - output));
+			if (!Reg::isSIMDAligned(input + head))
+			{
+				head = numSamples;
+			}
+
+			for (; i < head; ++i)
+			{
+				auto position = static_cast<SampleType>(i + 1);
+				output[i] = shaper.apply(input[i] * (inStart + inStep * position)) * (outStart + outStep * position);
+			}
+
+			//lane k holds the position of sample i + k
+			alignas(Reg::SIMDRegisterSize) std::array<SampleType, width> lanes;
+			for (size_t k = 0; k < width; ++k)
+			{
+				lanes[k] = static_cast<SampleType>(i + k + 1);
+			}
+
+			auto position = Reg::fromRawArray(lanes.data());
+			const auto advanceReg = Reg::expand(static_cast<SampleType>(width));
+			const auto inStartReg = Reg::expand(inStart), inStepReg = Reg::expand(inStep);
+			const auto outStartReg = Reg::expand(outStart), outStepReg = Reg::expand(outStep);
+
+			for (; i + width <= numSamples; i += width)
+			{
+				auto inReg = inStartReg + inStepReg * position;
+				auto outReg = outStartReg + outStepReg * position;
+				(shaper.apply(Reg::fromRawArray(input + i) * inReg) * outReg).copyToRawArray(output + i);
+				position += advanceReg;
+			}
+		}
+#endif
+
+		for (; i < numSamples; ++i)
+		{
+			auto position = static_cast<SampleType>(i + 1);
+			output[i] = shaper.apply(input[i] * (inStart + inStep * position)) * (outStart + outStep * position);
+		}
+	}
+
+	//works through the block in short chunks: the loudest channel per sample, its gain through the curve, then every channel scaled by it
+	template<typename Shaper>
+	static void shapeLinkedSamples(const Shaper& shaper, const juce::dsp::AudioBlock<SampleType>& block,
+		SampleType inStart, SampleType inStep, SampleType outStart, SampleType outStep) noexcept
+	{
+		constexpr size_t chunkSize = 64;
+		constexpr auto smallestPeak = SampleType(1.0e-6);
+
+		const auto numChannels = block.getNumChannels();
+		const auto numSamples = block.getNumSamples();
+		std::array<SampleType, chunkSize> gains;
+
+		for (size_t start = 0; start < numSamples; start += chunkSize)
+		{
+			const auto length = juce::jmin(chunkSize, numSamples - start);
+
+			std::fill_n(gains.begin(), length, SampleType(0));
+			for (size_t ch = 0; ch < numChannels; ++ch)
+			{
+				const auto* x = block.getChannelPointer(ch) + start;
+				for (size_t i = 0; i < length; ++i)
+				{
+					gains[i] = juce::jmax(gains[i], std::abs(x[i]));
+				}
+			}
+
+			//near silence the ratio tends to the curve's slope at zero, which smallestPeak stands in for
+			for (size_t i = 0; i < length; ++i)
+			{
+				auto position = static_cast<SampleType>(start + i + 1);
+				auto inScale = inStart + inStep * position;
+				auto peak = juce::jmax(gains[i] * inScale, smallestPeak);
+				gains[i] = shaper.apply(peak) / peak * inScale * (outStart + outStep * position);
+			}
+
+			for (size_t ch = 0; ch < numChannels; ++ch)
+			{
+				auto* x = block.getChannelPointer(ch) + start;
+				for (size_t i = 0; i < length; ++i)
+				{
+					x[i] *= gains[i];
+				}
+			}
+		}
+	}
+
+	static const std::array<Kernel, 4>& getKernels()
+	{
+		static constexpr std::array<Kernel, 4> kernels
+		{
+			&processSamples<Shapers::HardClip>,
+			&processSamples<Shapers::SoftClip>,
+			&processSamples<Shapers::Tanh>,
+			&processSamples<Shapers::Foldback>,
+		};
+		return kernels;
+	}
+
+	static const std::array<RampedKernel, 4>& getRampedKernels()
+	{
+		static constexpr std::array<RampedKernel, 4> kernels
+		{
+			&processSamplesRamped<Shapers::HardClip>,
+			&processSamplesRamped<Shapers::SoftClip>,
+			&processSamplesRamped<Shapers::Tanh>,
+			&processSamplesRamped<Shapers::Foldback>,
+		};
+		return kernels;
+	}
+
+	static const std::array<LinkedKernel, 4>& getLinkedKernels()
+	{
+		static constexpr std::array<LinkedKernel, 4> kernels
+		{
+			&processLinkedSamples<Shapers::HardClip>,
+			&processLinkedSamples<Shapers::SoftClip>,
+			&processLinkedSamples<Shapers::Tanh>,
+			&processLinkedSamples<Shapers::Foldback>,
+		};
+		return kernels;
+	}
+
+	static const std::array<AntiderivativeKernel, 4>& getAntiderivativeKernels(Shapers::Mode antialiasingMode)
+	{
+		static constexpr std::array<AntiderivativeKernel, 4> firstOrder
+		{
+			&processAntiderivativeSamples<Shapers::HardClip, 1>,
+			&processAntiderivativeSamples<Shapers::SoftClip, 1>,
+			&processAntiderivativeSamples<Shapers::Tanh, 1>,
+			&processAntiderivativeSamples<Shapers::Foldback, 1>,
+		};
+
+		static constexpr std::array<AntiderivativeKernel, 4> secondOrder
+		{
+			&processAntiderivativeSamples<Shapers::HardClip, 2>,
+			&processAntiderivativeSamples<Shapers::SoftClip, 2>,
+			&processAntiderivativeSamples<Shapers::Tanh, 2>,
+			&processAntiderivativeSamples<Shapers::Foldback, 2>,
+		};
+
+		return antialiasingMode == Shapers::Mode::secondOrderADAA ? secondOrder : firstOrder;
+	}
+};
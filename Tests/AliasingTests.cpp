@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    AliasingTests.cpp
+    Created: 17 Oct 2026 9:52:19pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Waveshapers.h"
+#include "Benchmark.h"
+#include "ShaperHelpers.h"
+
+namespace
+{
+	using namespace ShaperHelpers;
+
+	constexpr double sampleRate = 44100.0;
+	constexpr int fftOrder = 13;
+	constexpr int fftSize = 1 << fftOrder;
+
+	//odd, so no folded harmonic lands on a multiple of it, and about 2.5kHz, so the harmonics fold early
+	constexpr int fundamentalBin = 467;
+
+	//enough to push the clippers well past their knees
+	constexpr double drive = 20.0;
+
+	constexpr int oversamplingStages = 2;
+	constexpr int benchmarkBlockSize = 512;
+
+	//the folded-back energy against the harmonics' in dB, for a process(block) that shapes one fftSize block in place
+	template<typename Process>
+	double measureAliasing(Process&& process)
+	{
+		juce::AudioBuffer<double> buffer(1, fftSize);
+
+		//the sine repeats exactly once per block, so after a block to settle the output does too
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			auto* samples = buffer.getWritePointer(0);
+			for (int i = 0; i < fftSize; ++i)
+			{
+				samples[i] = std::sin(juce::MathConstants<double>::twoPi * fundamentalBin * i / fftSize);
+			}
+
+			auto block = juce::dsp::AudioBlock<double>(buffer);
+			process(block);
+		}
+
+		std::vector<float> fftData(2 * fftSize, 0.f);
+		std::transform(buffer.getReadPointer(0), buffer.getReadPointer(0) + fftSize, fftData.begin(), [](double sample) { return static_cast<float>(sample); });
+
+		juce::dsp::FFT fft(fftOrder);
+		fft.performRealOnlyForwardTransform(fftData.data(), true);
+
+		auto harmonicPower = 0.0, aliasPower = 0.0;
+		for (int bin = 1; bin <= fftSize / 2; ++bin)
+		{
+			const auto re = static_cast<double>(fftData[static_cast<size_t>(2 * bin)]);
+			const auto im = static_cast<double>(fftData[static_cast<size_t>(2 * bin + 1)]);
+			(bin % fundamentalBin == 0 ? harmonicPower : aliasPower) += re * re + im * im;
+		}
+
+		return 10.0 * std::log10(juce::jmax(aliasPower, 1.0e-30) / harmonicPower);
+	}
+
+	//the band's kernel on its own at the host rate, in whichever mode
+	struct DirectShaper
+	{
+		DirectShaper(Shapers::Shape shape, Shapers::Mode mode, int blockSize)
+		{
+			kernel.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+			kernel.setShape(shape);
+			kernel.setMode(mode);
+			kernel.setDrive(drive);
+			kernel.reset();
+		}
+
+		void process(juce::dsp::AudioBlock<double>& block)
+		{
+			kernel.process(juce::dsp::ProcessContextReplacing<double>(block));
+		}
+
+		DistortionKernel<double> kernel;
+	};
+
+	//the kernel inside the band's oversampler, the way DistortionBand runs it
+	struct OversampledShaper
+	{
+		OversampledShaper(Shapers::Shape shape, int blockSize) :
+			oversampler(1, oversamplingStages, juce::dsp::Oversampling<double>::filterHalfBandPolyphaseIIR, true, true)
+		{
+			oversampler.setUsingIntegerLatency(true);
+			oversampler.initProcessing(static_cast<size_t>(blockSize));
+
+			//the ramps run at the host rate, as in the band
+			kernel.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+			kernel.setShape(shape);
+			kernel.setDrive(drive);
+			kernel.reset();
+		}
+
+		void process(juce::dsp::AudioBlock<double>& block)
+		{
+			auto oversampledBlock = oversampler.processSamplesUp(block);
+			kernel.process(juce::dsp::ProcessContextReplacing<double>(oversampledBlock));
+			oversampler.processSamplesDown(block);
+		}
+
+		juce::dsp::Oversampling<double> oversampler;
+		DistortionKernel<double> kernel;
+	};
+}
+
+//the ADAA modes have to keep at least minReduction of their advantage over sampling the curve directly
+struct AliasingTests : juce::UnitTest
+{
+	AliasingTests() : juce::UnitTest("Antiderivative anti-aliasing", "MBDistortion") { }
+
+	void runTest() override
+	{
+		beginTest("ADAA aliases less than direct evaluation");
+
+		forEachShape([this](Shapers::Shape shape, auto shaper)
+		{
+			//foldback has no antiderivatives, its ADAA modes are the curve itself
+			if (decltype(shaper)::antiderivatives == 0)
+			{
+				return;
+			}
+
+			auto measure = [shape](Shapers::Mode mode)
+			{
+				DirectShaper shaper(shape, mode, fftSize);
+				return measureAliasing([&](auto& block) { shaper.process(block); });
+			};
+
+			const auto direct = measure(Shapers::Mode::direct);
+			expectLessThan(measure(Shapers::Mode::firstOrderADAA), direct - minReduction, getShapeName(shape));
+			expectLessThan(measure(Shapers::Mode::secondOrderADAA), direct - minReduction, getShapeName(shape));
+		});
+	}
+private:
+	//about half of what each curve measures at the harness's drive
+	static constexpr double minReduction = 3.0;
+};
+
+/*
+	How much each shaper mode aliases: a bin-centred sine well up the spectrum, driven hard through each curve.
+	With the output periodic in the FFT size, a rectangular window leaks nothing, so every bin that isn't a
+	harmonic holds only folded-back energy. Each mode is reported next to 4x oversampling, with what it costs.
+*/
+struct AliasingBenchmarks : juce::UnitTest
+{
+	AliasingBenchmarks() : juce::UnitTest("Shaper aliasing", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		beginTest("Aliasing and CPU of each mode");
+
+		auto random = getRandom();
+		juce::AudioBuffer<double> noise(1, benchmarkBlockSize);
+		Benchmark::fillWithNoise(noise, random);
+		juce::AudioBuffer<double> work(1, benchmarkBlockSize);
+
+		//each shaper works on a fresh copy of the same noise, so none of them settles into feeding back its own output
+		auto measureCost = [&](auto& shaper)
+		{
+			return Benchmark::measureSamplesPerSecond(benchmarkBlockSize, [&]
+			{
+				work.copyFrom(0, 0, noise, 0, 0, benchmarkBlockSize);
+				auto block = juce::dsp::AudioBlock<double>(work);
+				shaper.process(block);
+			});
+		};
+
+		forEachShape([&](Shapers::Shape shape, auto)
+		{
+			logMessage(getShapeName(shape));
+
+			for (auto mode : { Shapers::Mode::direct, Shapers::Mode::firstOrderADAA, Shapers::Mode::secondOrderADAA })
+			{
+				DirectShaper measured(shape, mode, fftSize), timed(shape, mode, benchmarkBlockSize);
+				report(getModeName(mode), measureAliasing([&](auto& block) { measured.process(block); }), measureCost(timed));
+			}
+
+			OversampledShaper measured(shape, fftSize), timed(shape, benchmarkBlockSize);
+			report("4x oversampling", measureAliasing([&](auto& block) { measured.process(block); }), measureCost(timed));
+		});
+	}
+private:
+	static const char* getModeName(Shapers::Mode mode)
+	{
+		switch (mode)
+		{
+		case Shapers::Mode::direct: return "Direct";
+		case Shapers::Mode::lookupTable: return "Lookup table";
+		case Shapers::Mode::firstOrderADAA: return "First order ADAA";
+		case Shapers::Mode::secondOrderADAA: return "Second order ADAA";
+		}
+
+		return "";
+	}
+
+	void report(const juce::String& mode, double aliasingDecibels, double samplesPerSecond)
+	{
+		logMessage("  " + mode.paddedRight(' ', 20) + juce::String(aliasingDecibels, 1) + " dB  " + Benchmark::formatRate(samplesPerSecond));
+	}
+};
+
+static AliasingTests aliasingTests;
+static AliasingBenchmarks aliasingBenchmarks;
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 17 Oct 2026 9:31:08pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//timing helpers shared by the harnesses in the "MBDistortion Benchmarks" category
+namespace Benchmark
+{
+	//calls fn, which processes numSamples samples each time, until minSeconds have gone by and returns the samples per second
+	template<typename Fn>
+	double measureSamplesPerSecond(int numSamples, Fn&& fn, double minSeconds = 0.25)
+	{
+		//one untimed call, so lazily built state and cold caches aren't counted
+		fn();
+
+		juce::int64 numCalls = 0;
+		auto elapsed = 0.0;
+		const auto start = juce::Time::getHighResolutionTicks();
+		do
+		{
+			fn();
+			++numCalls;
+			elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+		} while (elapsed < minSeconds);
+
+		return static_cast<double>(numCalls) * numSamples / elapsed;
+	}
+
+	inline juce::String formatRate(double samplesPerSecond)
+	{
+		return juce::String(samplesPerSecond / 1.0e6, 1) + " Msamples/s";
+	}
+
+	//fills every channel with full scale noise
+	template<typename SampleType>
+	void fillWithNoise(juce::AudioBuffer<SampleType>& buffer, juce::Random& random)
+	{
+		for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+		{
+			auto* samples = buffer.getWritePointer(channel);
+			for (int i = 0; i < buffer.getNumSamples(); ++i)
+			{
+				samples[i] = static_cast<SampleType>(random.nextFloat() * 2.f - 1.f);
+			}
+		}
+	}
+}
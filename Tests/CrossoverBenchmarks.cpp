@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    CrossoverBenchmarks.cpp
+    Created: 17 Oct 2026 10:37:52pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Params.h"
+#include "Crossover.h"
+#include "Benchmark.h"
+
+namespace
+{
+	using Crossover = MultiBandCrossover<float, Params::MaxBands>;
+
+	constexpr double sampleRate = 48000.0;
+	constexpr float lowMidFreq = 400.f;
+	constexpr float midHighFreq = 4000.f;
+
+	//the three band split as it used to be: every band copied from the input, then five filters in separate passes
+	struct FilterSplit
+	{
+		using Filter = juce::dsp::LinkwitzRileyFilter<float>;
+
+		FilterSplit(const juce::dsp::ProcessSpec& spec)
+		{
+			LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+			HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+			AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+			LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+			HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+
+			for (auto* filter : { &LP1, &HP1, &AP2, &LP2, &HP2 })
+			{
+				filter->prepare(spec);
+			}
+
+			LP1.setCutoffFrequency(lowMidFreq);
+			HP1.setCutoffFrequency(lowMidFreq);
+			AP2.setCutoffFrequency(midHighFreq);
+			LP2.setCutoffFrequency(midHighFreq);
+			HP2.setCutoffFrequency(midHighFreq);
+
+			for (auto& buffer : filterBuffers)
+			{
+				buffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+			}
+		}
+
+		void process(const juce::AudioBuffer<float>& inputBuffer)
+		{
+			for (auto& fb : filterBuffers)
+			{
+				fb = inputBuffer;
+			}
+
+			auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
+			auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
+			auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+
+			auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
+			auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
+			auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+
+			LP1.process(fb0Ctx);
+			AP2.process(fb0Ctx);
+
+			HP1.process(fb1Ctx);
+			filterBuffers[2] = filterBuffers[1];
+			LP2.process(fb1Ctx);
+			HP2.process(fb2Ctx);
+		}
+
+		Filter LP1, HP1, AP2, LP2, HP2;
+		std::array<juce::AudioBuffer<float>, 3> filterBuffers;
+	};
+
+	//the fused crossover set up for the same three bands
+	struct FusedSplit
+	{
+		FusedSplit(const juce::dsp::ProcessSpec& spec)
+		{
+			crossover.prepare(spec);
+			crossover.setNumBands(3);
+			crossover.setCrossoverFrequency(0, lowMidFreq);
+			crossover.setCrossoverFrequency(1, midHighFreq);
+
+			for (size_t band = 0; band < bandBuffers.size(); ++band)
+			{
+				bandBuffers[band].setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+				bands[band] = juce::dsp::AudioBlock<float>(bandBuffers[band]);
+			}
+		}
+
+		void process(const juce::AudioBuffer<float>& inputBuffer)
+		{
+			crossover.process(juce::dsp::AudioBlock<const float>(inputBuffer), bands);
+		}
+
+		Crossover crossover;
+		std::array<juce::AudioBuffer<float>, 3> bandBuffers;
+		Crossover::BandBlocks bands;
+	};
+
+	//a crossover per channel, each handed its channel on its own, so every channel takes the scalar path
+	struct PerChannelSplit
+	{
+		static constexpr int maxChannels = 8;
+
+		PerChannelSplit(const juce::dsp::ProcessSpec& spec)
+		{
+			jassert(spec.numChannels <= static_cast<juce::uint32>(maxChannels));
+
+			auto channelSpec = spec;
+			channelSpec.numChannels = 1;
+			for (auto& crossover : crossovers)
+			{
+				crossover.prepare(channelSpec);
+				crossover.setNumBands(3);
+				crossover.setCrossoverFrequency(0, lowMidFreq);
+				crossover.setCrossoverFrequency(1, midHighFreq);
+			}
+
+			for (auto& buffer : bandBuffers)
+			{
+				buffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+			}
+		}
+
+		void process(const juce::AudioBuffer<float>& inputBuffer)
+		{
+			auto input = juce::dsp::AudioBlock<const float>(inputBuffer);
+			for (size_t ch = 0; ch < input.getNumChannels(); ++ch)
+			{
+				Crossover::BandBlocks channelBands;
+				for (size_t band = 0; band < bandBuffers.size(); ++band)
+				{
+					channelBands[band] = juce::dsp::AudioBlock<float>(bandBuffers[band]).getSubsetChannelBlock(ch, 1);
+				}
+
+				crossovers[ch].process(input.getSubsetChannelBlock(ch, 1), channelBands);
+			}
+		}
+
+		std::array<Crossover, maxChannels> crossovers;
+		std::array<juce::AudioBuffer<float>, 3> bandBuffers;
+	};
+
+	//largest difference between two sets of band buffers
+	float getMaxDifference(const std::array<juce::AudioBuffer<float>, 3>& a, const std::array<juce::AudioBuffer<float>, 3>& b)
+	{
+		auto maxError = 0.f;
+		for (size_t band = 0; band < a.size(); ++band)
+		{
+			for (int channel = 0; channel < a[band].getNumChannels(); ++channel)
+			{
+				for (int i = 0; i < a[band].getNumSamples(); ++i)
+				{
+					maxError = juce::jmax(maxError, std::abs(a[band].getSample(channel, i) - b[band].getSample(channel, i)));
+				}
+			}
+		}
+
+		return maxError;
+	}
+}
+
+/*
+	The fused crossover against the five LinkwitzRileyFilter passes it replaced, on stereo blocks from the
+	smallest a host sends to the largest. The two are checked to split a block the same way before timing.
+*/
+struct CrossoverBenchmarks : juce::UnitTest
+{
+	CrossoverBenchmarks() : juce::UnitTest("Fused crossover against splitBands", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		auto random = getRandom();
+
+		for (auto blockSize : { 32, 256, 2048 })
+		{
+			beginTest(juce::String(blockSize) + " sample blocks");
+
+			const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+			FilterSplit filterSplit(spec);
+			FusedSplit fusedSplit(spec);
+
+			juce::AudioBuffer<float> input(numChannels, blockSize);
+			Benchmark::fillWithNoise(input, random);
+
+			filterSplit.process(input);
+			fusedSplit.process(input);
+			for (size_t band = 0; band < 3; ++band)
+			{
+				auto maxError = 0.f;
+				for (int channel = 0; channel < numChannels; ++channel)
+				{
+					for (int i = 0; i < blockSize; ++i)
+					{
+						maxError = juce::jmax(maxError, std::abs(fusedSplit.bandBuffers[band].getSample(channel, i) - filterSplit.filterBuffers[band].getSample(channel, i)));
+					}
+				}
+				expectLessThan(maxError, 1.0e-4f, "band " + juce::String(static_cast<int>(band)));
+			}
+
+			const auto filterRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&] { filterSplit.process(input); });
+			const auto fusedRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&] { fusedSplit.process(input); });
+
+			logMessage("  splitBands " + Benchmark::formatRate(filterRate) + ", fused crossover " + Benchmark::formatRate(fusedRate)
+				+ ", " + juce::String(fusedRate / filterRate, 2) + "x");
+		}
+	}
+private:
+	static constexpr int numChannels = 2;
+};
+
+/*
+	Channels run in SIMD lanes against each channel running on its own, for mono, stereo and 7.1. Mono has no
+	second lane to fill, so both sides run the scalar path there and should time the same.
+*/
+struct CrossoverLaneBenchmarks : juce::UnitTest
+{
+	CrossoverLaneBenchmarks() : juce::UnitTest("Crossover channels in SIMD lanes against one at a time", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		auto random = getRandom();
+
+		for (auto layout : { juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo(), juce::AudioChannelSet::create7point1() })
+		{
+			const auto numChannels = layout.size();
+			beginTest(layout.getDescription());
+
+			const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+			PerChannelSplit perChannelSplit(spec);
+			FusedSplit laneSplit(spec);
+
+			juce::AudioBuffer<float> input(numChannels, blockSize);
+			Benchmark::fillWithNoise(input, random);
+
+			//the lanes do the same arithmetic in the same order, so nothing but rounding should differ
+			perChannelSplit.process(input);
+			laneSplit.process(input);
+			expectLessThan(getMaxDifference(perChannelSplit.bandBuffers, laneSplit.bandBuffers), 1.0e-6f);
+
+			const auto scalarRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&] { perChannelSplit.process(input); });
+			const auto laneRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&] { laneSplit.process(input); });
+
+			logMessage("  one at a time " + Benchmark::formatRate(scalarRate) + ", in lanes " + Benchmark::formatRate(laneRate)
+				+ ", " + juce::String(laneRate / scalarRate, 2) + "x");
+		}
+	}
+private:
+	static constexpr int blockSize = 512;
+};
+
+static CrossoverBenchmarks crossoverBenchmarks;
+static CrossoverLaneBenchmarks crossoverLaneBenchmarks;
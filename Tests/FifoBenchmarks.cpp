@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    FifoBenchmarks.cpp
+    Created: 17 Oct 2026 10:08:44pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Fifo.h"
+#include "Benchmark.h"
+
+/*
+	The analyzer's two fifos carried through a full hand-off per frame, both the copying way (build it aside,
+	push a copy, pull a copy) and through the slots (build it in place, read or swap it out where it sits).
+	The frames are the 2048 point FFT's, the paths about what an editor-wide spectrum line holds.
+*/
+struct FifoBenchmarks : juce::UnitTest
+{
+	FifoBenchmarks() : juce::UnitTest("Fifo slot hand-off against copying", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		beginTest("FFT frames");
+		{
+			Fifo<std::vector<float>> fifo;
+			fifo.prepare(static_cast<size_t>(frameSize));
+
+			std::vector<float> frame(frameSize), received(frameSize);
+			auto total = 0.f;
+
+			const auto copied = Benchmark::measureSamplesPerSecond(1, [&]
+			{
+				renderFrame(frame);
+				fifo.push(frame);
+				fifo.pull(received);
+				total += received.front();
+			});
+
+			const auto inPlace = Benchmark::measureSamplesPerSecond(1, [&]
+			{
+				renderFrame(*fifo.acquireWriteSlot());
+				fifo.commitWriteSlot();
+				total += fifo.acquireReadSlot()->front();
+				fifo.releaseReadSlot();
+			});
+
+			report(copied, inPlace);
+			expect(total > 0.f);
+		}
+
+		beginTest("Paths");
+		{
+			Fifo<juce::Path> fifo;
+			juce::Path path, received;
+			auto total = 0.f;
+
+			const auto copied = Benchmark::measureSamplesPerSecond(1, [&]
+			{
+				buildPath(path);
+				fifo.push(path);
+				fifo.pull(received);
+				total += received.getBounds().getWidth();
+			});
+
+			const auto inPlace = Benchmark::measureSamplesPerSecond(1, [&]
+			{
+				buildPath(*fifo.acquireWriteSlot());
+				fifo.commitWriteSlot();
+				std::swap(received, *fifo.acquireReadSlot());
+				fifo.releaseReadSlot();
+				total += received.getBounds().getWidth();
+			});
+
+			report(copied, inPlace);
+			expect(total > 0.f);
+		}
+	}
+private:
+	static constexpr int frameSize = 2 * 2048;
+	static constexpr int pathPoints = 1000;
+
+	//stands in for the FFT, a frame costs about as much to write either way
+	static void renderFrame(std::vector<float>& frame)
+	{
+		std::fill(frame.begin(), frame.end(), 1.f);
+	}
+
+	//what AnalyzerPathGenerator does to whichever path it's handed
+	static void buildPath(juce::Path& path)
+	{
+		path.clear();
+		path.preallocateSpace(3 * pathPoints);
+		path.startNewSubPath(0.f, 0.f);
+		for (int i = 1; i < pathPoints; ++i)
+		{
+			path.lineTo(static_cast<float>(i), static_cast<float>(i % 100));
+		}
+	}
+
+	void report(double copiedPerSecond, double inPlacePerSecond)
+	{
+		logMessage("  copied " + juce::String(1.0e6 / copiedPerSecond, 3) + " us per frame, in place "
+			+ juce::String(1.0e6 / inPlacePerSecond, 3) + " us per frame, " + juce::String(inPlacePerSecond / copiedPerSecond, 2) + "x");
+	}
+};
+
+static FifoBenchmarks fifoBenchmarks;
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 9:12:40pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+/*
+	Runs the MBDistortion unit tests, or with --bench the benchmarks and measurement harnesses, which only
+	report numbers. --seed <n> repeats a run that failed. Returns non-zero if any expectation failed.
+*/
+int main(int argc, char* argv[])
+{
+	//the processor's parameters and timers expect a message manager, even though nothing here dispatches messages
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	const auto args = juce::StringArray(argv + 1, argc - 1);
+	const auto category = args.contains("--bench") ? juce::String("MBDistortion Benchmarks") : juce::String("MBDistortion");
+
+	auto seedIndex = args.indexOf("--seed");
+	auto seed = seedIndex >= 0 ? args[seedIndex + 1].getLargeIntValue() : juce::Random::getSystemRandom().nextInt64();
+
+	juce::UnitTestRunner runner;
+	runner.setAssertOnFailure(false);
+	runner.runTestsInCategory(category, seed);
+
+	for (int i = 0; i < runner.getNumResults(); ++i)
+	{
+		if (runner.getResult(i)->failures > 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
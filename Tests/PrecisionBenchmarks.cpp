@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    PrecisionBenchmarks.cpp
+    Created: 17 Oct 2026 10:54:16pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr double sampleRate = 48000.0;
+	constexpr int blockSize = 512;
+	constexpr int numChannels = 2;
+
+	std::unique_ptr<MBDistortionAudioProcessor> createProcessor(juce::AudioProcessor::ProcessingPrecision precision)
+	{
+		auto processor = std::make_unique<MBDistortionAudioProcessor>();
+		processor->setProcessingPrecision(precision);
+		processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+		processor->prepareToPlay(sampleRate, blockSize);
+		return processor;
+	}
+}
+
+/*
+	The whole processor at its default settings in float, in double, and in float behind the conversion a
+	64-bit host needed before there was a double path. Every block starts from the same noise, so the
+	shapers never settle into clipping their own output and the processor never sees silence.
+*/
+struct PrecisionBenchmarks : juce::UnitTest
+{
+	PrecisionBenchmarks() : juce::UnitTest("Float against double processing", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		beginTest("Processor throughput");
+
+		auto random = getRandom();
+		juce::AudioBuffer<double> noise(numChannels, blockSize), doubleWork(numChannels, blockSize);
+		Benchmark::fillWithNoise(noise, random);
+
+		juce::AudioBuffer<float> floatNoise(numChannels, blockSize), floatWork(numChannels, blockSize);
+		floatNoise.makeCopyOf(noise, true);
+
+		juce::MidiBuffer midi;
+
+		auto floatProcessor = createProcessor(juce::AudioProcessor::singlePrecision);
+		const auto floatRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&]
+		{
+			floatWork.makeCopyOf(floatNoise, true);
+			floatProcessor->processBlock(floatWork, midi);
+		});
+
+		auto doubleProcessor = createProcessor(juce::AudioProcessor::doublePrecision);
+		const auto doubleRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&]
+		{
+			doubleWork.makeCopyOf(noise, true);
+			doubleProcessor->processBlock(doubleWork, midi);
+		});
+
+		//what the plugin wrapper does for a double host when the processor only takes float
+		const auto convertedRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&]
+		{
+			floatWork.makeCopyOf(noise, true);
+			floatProcessor->processBlock(floatWork, midi);
+			doubleWork.makeCopyOf(floatWork, true);
+		});
+
+		logMessage("  float " + Benchmark::formatRate(floatRate));
+		logMessage("  double " + Benchmark::formatRate(doubleRate) + ", " + juce::String(doubleRate / floatRate, 2) + "x float");
+		logMessage("  double host through float " + Benchmark::formatRate(convertedRate) + ", " + juce::String(convertedRate / floatRate, 2) + "x float");
+
+		floatProcessor->releaseResources();
+		doubleProcessor->releaseResources();
+	}
+};
+
+static PrecisionBenchmarks precisionBenchmarks;
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    RealtimeTests.cpp
+    Created: 17 Oct 2026 9:12:40pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "RealtimeChecks.h"
+
+/*
+	Drives the processor the way hosts do, through random sample rates, random block sizes (including ones past
+	what it was prepared for), every setting changing mid-stream and silence, in both precisions, and expects the
+	real-time checks around processBlock and the band workers to have caught nothing.
+
+	Every other session keeps parallel bands on with blocks big enough to use them. The runner's thread is the
+	message thread, so switching them on here starts the workers the way a click in the editor would.
+
+	The checks only count locks on Linux (see RealtimeChecks.h); elsewhere this only catches allocations.
+*/
+struct RealtimeTests : juce::UnitTest
+{
+	RealtimeTests() : juce::UnitTest("Audio thread stays real-time safe", "MBDistortion") { }
+
+	void runTest() override
+	{
+		auto random = getRandom();
+
+		if (!RealtimeChecks::detectsLocks)
+		{
+			logMessage("Locks aren't detected on this platform, only allocations are checked");
+		}
+
+		beginTest("Float processing");
+		for (int session = 0; session < numSessions; ++session)
+		{
+			runSession<float>(random, session % 2 == 0);
+		}
+
+		beginTest("Double processing");
+		for (int session = 0; session < numSessions; ++session)
+		{
+			runSession<double>(random, session % 2 == 0);
+		}
+	}
+private:
+	static constexpr int numSessions = 12;
+	static constexpr int numBlocks = 400;
+
+	//parallel sessions put the switch back on afterwards, the others see it toggled at random
+	static void randomiseParameters(MBDistortionAudioProcessor& processor, juce::Random& random, bool parallel)
+	{
+		for (int i = 0; i < Params::NumParams; ++i)
+		{
+			if (auto* parameter = processor.apvts.getParameter(Params::ParamIDs[static_cast<size_t>(i)]))
+			{
+				parameter->setValueNotifyingHost(i == Params::Parallel_Bands && parallel ? 1.f : random.nextFloat());
+			}
+		}
+	}
+
+	template<typename SampleType>
+	void runSession(juce::Random& random, bool parallel)
+	{
+		static constexpr std::array<double, 7> sampleRates{ 22050.0, 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+
+		//the processor doesn't hand blocks under 256 samples to the workers
+		const auto sampleRate = sampleRates[static_cast<size_t>(random.nextInt(static_cast<int>(sampleRates.size())))];
+		const auto blockSize = 1 << random.nextInt(parallel ? juce::Range<int>{ 9, 13 } : juce::Range<int>{ 4, 13 });
+
+		//heap allocated like a host would, the band chains are too big to sit on the stack
+		auto processorOwner = std::make_unique<MBDistortionAudioProcessor>();
+		auto& processor = *processorOwner;
+		processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+		randomiseParameters(processor, random, parallel);
+
+		processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+
+		//room for hosts that hand over more than they promised, allocated here rather than inside the checks
+		juce::AudioBuffer<SampleType> buffer(processor.getTotalNumInputChannels(), blockSize * 2);
+		juce::MidiBuffer midi;
+
+		const auto violationsBefore = RealtimeChecks::getNumViolations();
+
+		for (int block = 0; block < numBlocks; ++block)
+		{
+			if (random.nextInt(16) == 0)
+			{
+				randomiseParameters(processor, random, parallel);
+			}
+
+			const auto numSamples = random.nextInt(8) == 0 ? random.nextInt({ 1, blockSize * 2 + 1 }) : random.nextInt({ 1, blockSize + 1 });
+			const auto level = random.nextInt(4) == 0 ? SampleType(0) : static_cast<SampleType>(random.nextFloat());
+
+			juce::AudioBuffer<SampleType> hostBuffer(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+			for (int channel = 0; channel < hostBuffer.getNumChannels(); ++channel)
+			{
+				auto* samples = hostBuffer.getWritePointer(channel);
+				for (int i = 0; i < numSamples; ++i)
+				{
+					samples[i] = level * static_cast<SampleType>(random.nextFloat() * 2.f - 1.f);
+				}
+			}
+
+			processor.processBlock(hostBuffer, midi);
+		}
+
+		processor.releaseResources();
+
+		expectEquals(RealtimeChecks::getNumViolations() - violationsBefore, 0,
+			juce::String(RealtimeChecks::getLastViolation()) + " at " + juce::String(sampleRate) + "Hz with " + juce::String(blockSize)
+			+ " sample blocks" + (parallel ? ", bands in parallel" : ""));
+	}
+};
+
+static RealtimeTests realtimeTests;
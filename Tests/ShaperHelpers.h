@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    ShaperHelpers.h
+    Created: 17 Oct 2026 9:52:19pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Waveshapers.h"
+
+namespace ShaperHelpers
+{
+	//calls fn(shape, shaper) once for every curve
+	template<typename Fn>
+	void forEachShape(Fn&& fn)
+	{
+		fn(Shapers::Shape::hardClip, Shapers::HardClip{});
+		fn(Shapers::Shape::softClip, Shapers::SoftClip{});
+		fn(Shapers::Shape::tanh, Shapers::Tanh{});
+		fn(Shapers::Shape::foldback, Shapers::Foldback{});
+	}
+
+	inline const char* getShapeName(Shapers::Shape shape)
+	{
+		switch (shape)
+		{
+		case Shapers::Shape::hardClip: return "Hard clip";
+		case Shapers::Shape::softClip: return "Soft clip";
+		case Shapers::Shape::tanh: return "Tanh";
+		case Shapers::Shape::foldback: return "Foldback";
+		}
+
+		return "";
+	}
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    ShaperKernelBenchmarks.cpp
+    Created: 17 Oct 2026 10:21:37pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Waveshapers.h"
+#include "Benchmark.h"
+
+namespace
+{
+	//the band as it used to be: three passes over the block, the clipper called through a std::function per sample
+	struct ProcessorChainBand
+	{
+		using WaveShaper = juce::dsp::WaveShaper<float, std::function<float(float)>>;
+
+		ProcessorChainBand(const juce::dsp::ProcessSpec& spec, float inputGainDecibels, float driveInGain, float outputGainDecibels)
+		{
+			chain.prepare(spec);
+			chain.get<0>().setGainDecibels(inputGainDecibels);
+			chain.get<2>().setGainDecibels(outputGainDecibels);
+
+			float clipping{ 0.5f };
+			chain.get<1>().functionToUse = [driveInGain, clipping](float x)
+			{
+				return juce::jlimit(-clipping, clipping, x * (driveInGain / 10)) * 1 / clipping;
+			};
+		}
+
+		void process(juce::dsp::AudioBlock<float>& block)
+		{
+			chain.process(juce::dsp::ProcessContextReplacing<float>(block));
+		}
+
+		juce::dsp::ProcessorChain<juce::dsp::Gain<float>, WaveShaper, juce::dsp::Gain<float>> chain;
+	};
+
+	//the same settings through the fused kernel, which takes the SIMD path for the hard clipper
+	struct FusedKernelBand
+	{
+		FusedKernelBand(const juce::dsp::ProcessSpec& spec, float inputGainDecibels, float driveInGain, float outputGainDecibels)
+		{
+			kernel.prepare(spec);
+			kernel.setShape(Shapers::Shape::hardClip);
+			kernel.setInputGainDecibels(inputGainDecibels);
+			kernel.setDrive(driveInGain);
+			kernel.setOutputGainDecibels(outputGainDecibels);
+			kernel.reset();
+		}
+
+		void process(juce::dsp::AudioBlock<float>& block)
+		{
+			kernel.process(juce::dsp::ProcessContextReplacing<float>(block));
+		}
+
+		DistortionKernel<float> kernel;
+	};
+}
+
+/*
+	Throughput of the fused gain, clip and gain kernel against the ProcessorChain it replaced, on stereo blocks
+	from the smallest a host sends to the largest. Each block starts from the same noise, so neither side ends
+	up clipping its own already clipped output. The two outputs are checked against each other first.
+*/
+struct ShaperKernelBenchmarks : juce::UnitTest
+{
+	ShaperKernelBenchmarks() : juce::UnitTest("Fused kernel against the ProcessorChain", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		auto random = getRandom();
+
+		for (auto blockSize : { 32, 256, 2048 })
+		{
+			beginTest(juce::String(blockSize) + " sample blocks");
+
+			const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+			ProcessorChainBand processorChain(spec, inputGainDecibels, driveInGain, outputGainDecibels);
+			FusedKernelBand fusedKernel(spec, inputGainDecibels, driveInGain, outputGainDecibels);
+
+			juce::AudioBuffer<float> noise(numChannels, blockSize), work(numChannels, blockSize), reference(numChannels, blockSize);
+			Benchmark::fillWithNoise(noise, random);
+
+			auto processCopy = [&](auto& band, juce::AudioBuffer<float>& buffer)
+			{
+				for (int channel = 0; channel < numChannels; ++channel)
+				{
+					buffer.copyFrom(channel, 0, noise, channel, 0, blockSize);
+				}
+
+				auto block = juce::dsp::AudioBlock<float>(buffer);
+				band.process(block);
+			};
+
+			processCopy(processorChain, reference);
+			processCopy(fusedKernel, work);
+			for (int channel = 0; channel < numChannels; ++channel)
+			{
+				for (int i = 0; i < blockSize; ++i)
+				{
+					expectWithinAbsoluteError(work.getSample(channel, i), reference.getSample(channel, i), 1.0e-5f);
+				}
+			}
+
+			const auto chainRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&] { processCopy(processorChain, work); });
+			const auto kernelRate = Benchmark::measureSamplesPerSecond(blockSize * numChannels, [&] { processCopy(fusedKernel, work); });
+
+			logMessage("  ProcessorChain " + Benchmark::formatRate(chainRate) + ", fused kernel " + Benchmark::formatRate(kernelRate)
+				+ ", " + juce::String(kernelRate / chainRate, 2) + "x");
+		}
+	}
+private:
+	static constexpr double sampleRate = 48000.0;
+	static constexpr int numChannels = 2;
+
+	//about half the samples clip
+	static constexpr float inputGainDecibels = 3.f;
+	static constexpr float driveInGain = 10.f;
+	static constexpr float outputGainDecibels = -2.f;
+};
+
+static ShaperKernelBenchmarks shaperKernelBenchmarks;
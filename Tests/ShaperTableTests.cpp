@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    ShaperTableTests.cpp
+    Created: 17 Oct 2026 9:31:08pm
+    Author:  xande
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Waveshapers.h"
+#include "ShaperTables.h"
+#include "Benchmark.h"
+#include "ShaperHelpers.h"
+
+namespace
+{
+	using namespace ShaperHelpers;
+
+	//largest difference from the curve over twice the table's span, so the clamped or wrapped ends are covered too
+	template<typename Shaper, typename Lookup>
+	double measureLookupError(Lookup&& lookup)
+	{
+		constexpr int numPoints = 100003;
+
+		auto maxError = 0.0;
+		for (int i = 0; i < numPoints; ++i)
+		{
+			const auto x = -2.0 * Shaper::tableRange + 4.0 * Shaper::tableRange * i / (numPoints - 1);
+			maxError = juce::jmax(maxError, std::abs(static_cast<double>(lookup(x)) - Shaper::apply(x)));
+		}
+
+		return maxError;
+	}
+
+	//Shapers::Table's grid, storage and interpolation at any size, since the real one is fixed at compile time
+	template<typename Shaper>
+	double measureTableError(int size)
+	{
+		std::vector<float> values(static_cast<size_t>(size) + 1);
+		for (int i = 0; i < size; ++i)
+		{
+			values[static_cast<size_t>(i)] = static_cast<float>(Shaper::apply(-Shaper::tableRange + 2.0 * Shaper::tableRange * i / (size - 1)));
+		}
+		values[static_cast<size_t>(size)] = values[static_cast<size_t>(size - 1)];
+
+		return measureLookupError<Shaper>([&](double x)
+		{
+			auto position = (x + Shaper::tableRange) * (0.5 / Shaper::tableRange);
+			if (Shaper::tableWraps)
+			{
+				position -= std::floor(position);
+			}
+
+			position = juce::jlimit(0.0, 1.0, position) * (size - 1);
+			const auto index = static_cast<size_t>(position);
+			const auto a = static_cast<double>(values[index]);
+			return a + (static_cast<double>(values[index + 1]) - a) * (position - static_cast<double>(index));
+		});
+	}
+
+	//the curve's largest |f''| between kinks; the kinks themselves sit on the grid at every size tested
+	template<typename Shaper>
+	constexpr double getMaxCurvature()
+	{
+		if constexpr (std::is_same_v<Shaper, Shapers::SoftClip>)
+			return 3.0;                      //1.5x - 0.5x^3 at x = +-1
+		else if constexpr (std::is_same_v<Shaper, Shapers::Tanh>)
+			return 0.769800358919501;        //4 / (3 sqrt(3)), at atanh(1 / sqrt(3))
+		else
+			return 0.0;                      //hard clip and foldback are straight between their kinks
+	}
+
+	//linear interpolation is off by at most h^2 / 8 times the curvature, the clamped end by however far the
+	//curve still moves past the span, and the float storage by half an ulp of 1 on either neighbour
+	template<typename Shaper>
+	double getErrorBound(int size)
+	{
+		const auto spacing = 2.0 * Shaper::tableRange / (size - 1);
+		const auto tail = Shaper::tableWraps ? 0.0 : std::abs(Shaper::apply(2.0 * Shaper::tableRange) - Shaper::apply(Shaper::tableRange));
+		return getMaxCurvature<Shaper>() * spacing * spacing / 8.0 + tail + 1.0e-7;
+	}
+}
+
+/*
+	How closely the interpolated tables follow the curves they stand in for. Every size keeps the clippers' kinks
+	on the grid, so the error left is the curvature between grid points and the tables' float storage, and each
+	size has to stay inside what that predicts.
+*/
+struct ShaperTableTests : juce::UnitTest
+{
+	ShaperTableTests() : juce::UnitTest("Shaper lookup table accuracy", "MBDistortion") { }
+
+	void runTest() override
+	{
+		beginTest("Accuracy against table size");
+		forEachShape([this](Shapers::Shape shape, auto shaper)
+		{
+			using Shaper = decltype(shaper);
+
+			auto line = juce::String(getShapeName(shape)) + ":";
+			for (auto size : { 65, 257, 1025, 4097, 16385 })
+			{
+				const auto error = measureTableError<Shaper>(size);
+				line << "  " << size << " points " << juce::String(error, 9);
+				expectLessThan(error, getErrorBound<Shaper>(size), juce::String(getShapeName(shape)) + " at " + juce::String(size) + " points");
+			}
+			logMessage(line);
+		});
+
+		beginTest("Shipped tables");
+		ShaperTables::prepare();
+		forEachShape([this](Shapers::Shape shape, auto shaper)
+		{
+			using Shaper = decltype(shaper);
+
+			const auto& table = ShaperTables::get(shape);
+			expect(table.shape == shape, getShapeName(shape));
+
+			const auto error = measureLookupError<Shaper>([&](double x) { return table.lookup(x); });
+			expectLessThan(error, maxTableError, getShapeName(shape));
+		});
+	}
+private:
+	//tanh is the worst of the shipped curves, at about 1.5e-6
+	static constexpr double maxTableError = 1.0e-5;
+};
+
+/*
+	What the tables save: the band kernel over oversampled stereo blocks, evaluating each curve directly and
+	through its table, hot enough that the clippers and the table's interpolation both get exercised.
+*/
+struct ShaperTableBenchmarks : juce::UnitTest
+{
+	ShaperTableBenchmarks() : juce::UnitTest("Shaper lookup tables against direct evaluation", "MBDistortion Benchmarks") { }
+
+	void runTest() override
+	{
+		beginTest("CPU against direct evaluation");
+
+		auto random = getRandom();
+		juce::AudioBuffer<float> input(numChannels, blockSize), output(numChannels, blockSize);
+		Benchmark::fillWithNoise(input, random);
+
+		forEachShape([&](Shapers::Shape shape, auto shaper)
+		{
+			using Shaper = decltype(shaper);
+
+			auto table = std::make_unique<Shapers::Table>();
+			table->fill<Shaper>(shape);
+
+			DistortionKernel<float> kernel;
+			kernel.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+			kernel.setShape(shape);
+			kernel.setDrive(drive);
+			kernel.reset();
+
+			auto inputBlock = juce::dsp::AudioBlock<const float>(input);
+			auto outputBlock = juce::dsp::AudioBlock<float>(output);
+			auto processBlock = [&] { kernel.process(juce::dsp::ProcessContextNonReplacing<float>(inputBlock, outputBlock)); };
+
+			kernel.setTable(nullptr);
+			const auto direct = Benchmark::measureSamplesPerSecond(blockSize * numChannels, processBlock);
+
+			kernel.setTable(table.get());
+			const auto lookup = Benchmark::measureSamplesPerSecond(blockSize * numChannels, processBlock);
+
+			logMessage(juce::String(getShapeName(shape)) + ": direct " + Benchmark::formatRate(direct)
+				+ ", table " + Benchmark::formatRate(lookup) + ", " + juce::String(lookup / direct, 2) + "x");
+		});
+	}
+private:
+	//a band at 4x oversampling, driven hard enough that most samples land past the clippers' knees
+	static constexpr double sampleRate = 4 * 48000.0;
+	static constexpr int blockSize = 4 * 512;
+	static constexpr int numChannels = 2;
+	static constexpr float drive = 20.f;
+};
+
+static ShaperTableTests shaperTableTests;
+static ShaperTableBenchmarks shaperTableBenchmarks;